@@ -0,0 +1,67 @@
+// Compares how many times per second events with many handlers can be raised from a growing number of threads, with
+// the default event and with event_policy::lock_free. Built on Windows only, against the projection of the local
+// metadata.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <winrt/Windows.Foundation.h>
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    template <typename Event>
+    double raise_per_second(std::size_t const handlers, std::size_t const threads)
+    {
+        Event event;
+        std::atomic<std::uint64_t> calls{};
+
+        for (std::size_t index{}; index != handlers; ++index)
+        {
+            event.add([&](auto&&...)
+                {
+                    calls.fetch_add(1, std::memory_order_relaxed);
+                });
+        }
+
+        std::vector<std::thread> workers;
+        auto const start = std::chrono::steady_clock::now();
+
+        for (std::size_t index{}; index != threads; ++index)
+        {
+            workers.emplace_back([&]
+                {
+                    for (int raise{}; raise != 10'000; ++raise)
+                    {
+                        event(0, 0);
+                    }
+                });
+        }
+
+        for (auto&& worker : workers)
+        {
+            worker.join();
+        }
+
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        return 10'000.0 * threads / elapsed.count();
+    }
+}
+
+int main()
+{
+    using handler = TypedEventHandler<int, int>;
+    auto const hardware_threads = (std::max)(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t threads = 1; threads <= hardware_threads; threads *= 2)
+    {
+        auto const locked = raise_per_second<event<handler>>(200, threads);
+        auto const lock_free = raise_per_second<event<handler, event_policy::lock_free>>(200, threads);
+        std::printf("threads %zu: locked %.0f/s, lock_free %.0f/s\n", threads, locked, lock_free);
+    }
+}
@@ -0,0 +1,343 @@
+// Checks and measures heap_block_pool, the pool behind WINRT_HSTRING_POOL, on any host, along with the string
+// functions that decide which strings go back to it. The heap functions they call are stubbed with malloc and free,
+// counting the calls, so the checks can tell when a block came from or went back to the pool. Exits with a nonzero
+// code if any check fails, then prints how many blocks per second threads can allocate and release with and without
+// the pool.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    std::atomic<std::uint64_t> heap_allocations{};
+    std::atomic<std::uint64_t> heap_frees{};
+
+    // Each block is preceded by its size, which HeapSize reports.
+    constexpr std::size_t heap_prefix{ alignof(std::max_align_t) };
+}
+
+void* WINRT_IMPL_GetProcessHeap() noexcept
+{
+    static int heap;
+    return &heap;
+}
+
+void* WINRT_IMPL_HeapAlloc(void*, std::uint32_t, std::size_t const bytes) noexcept
+{
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    auto const block = static_cast<char*>(std::malloc(heap_prefix + bytes));
+
+    if (!block)
+    {
+        return nullptr;
+    }
+
+    std::memcpy(block, &bytes, sizeof(bytes));
+    return block + heap_prefix;
+}
+
+std::int32_t WINRT_IMPL_HeapFree(void*, std::uint32_t, void* const value) noexcept
+{
+    heap_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(static_cast<char*>(value) - heap_prefix);
+    return 1;
+}
+
+std::size_t WINRT_IMPL_HeapSize(void*, std::uint32_t, void const* const value) noexcept
+{
+    std::size_t bytes;
+    std::memcpy(&bytes, static_cast<char const*>(value) - heap_prefix, sizeof(bytes));
+    return bytes;
+}
+
+#define WINRT_EXPORT
+#define WINRT_ASSERT assert
+#define WINRT_HSTRING_POOL
+#include "../strings/base_string_pool.h"
+#include "base_string_impl.h"
+
+namespace
+{
+    using winrt::impl::heap_block_pool;
+
+    int failures{};
+
+    void check(bool const condition, char const* const expression, int const line)
+    {
+        if (!condition)
+        {
+            std::printf("hstring_pool.cpp(%d): check failed: %s\n", line, expression);
+            ++failures;
+        }
+    }
+
+#define CHECK(expression) check(expression, #expression, __LINE__)
+
+    // The sizes of hstrings with up to 200 characters, in which the shorter strings are the more common.
+    std::vector<std::size_t> make_sizes(std::uint32_t const seed)
+    {
+        std::mt19937 engine{ seed };
+        std::geometric_distribution<std::size_t> length{ 1.0 / 24 };
+        std::vector<std::size_t> sizes(4096);
+
+        for (auto&& size : sizes)
+        {
+            size = 32 + sizeof(wchar_t) * (1 + length(engine) % 200);
+        }
+
+        return sizes;
+    }
+
+    void* allocate(bool const pooled, std::size_t const bytes)
+    {
+        if (auto const size_class = heap_block_pool::get_class(bytes); pooled && size_class < heap_block_pool::class_count)
+        {
+            return heap_block_pool::allocate(size_class);
+        }
+
+        return WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, bytes);
+    }
+
+    void release(bool const pooled, void* const block, std::size_t const bytes)
+    {
+        if (auto const size_class = heap_block_pool::get_class(bytes); pooled && size_class < heap_block_pool::class_count)
+        {
+            heap_block_pool::release(block, size_class);
+        }
+        else
+        {
+            WINRT_IMPL_HeapFree(WINRT_IMPL_GetProcessHeap(), 0, block);
+        }
+    }
+
+    void test_classes()
+    {
+        CHECK(heap_block_pool::get_class(1) == 0);
+        CHECK(heap_block_pool::get_class(64) == 0);
+        CHECK(heap_block_pool::get_class(65) == 1);
+        CHECK(heap_block_pool::get_class(512) == 3);
+        CHECK(heap_block_pool::get_class(513) == heap_block_pool::class_count);
+
+        for (std::uint32_t size_class{}; size_class != heap_block_pool::class_count; ++size_class)
+        {
+            CHECK(heap_block_pool::get_class(heap_block_pool::class_size(size_class)) == size_class);
+        }
+    }
+
+    void test_reuse()
+    {
+        // A released block is handed out again without calling the heap.
+        auto const first = heap_block_pool::allocate(1);
+        heap_block_pool::release(first, 1);
+        auto const allocations = heap_allocations.load();
+        auto const second = heap_block_pool::allocate(1);
+        CHECK(second == first);
+        CHECK(heap_allocations == allocations);
+        heap_block_pool::release(second, 1);
+
+        // Blocks of one class are never handed out for another.
+        auto const other = heap_block_pool::allocate(2);
+        CHECK(other != first);
+        heap_block_pool::release(other, 2);
+    }
+
+    void test_threads()
+    {
+        // A thread that exits hands its blocks to the shared list, from which other threads take them.
+        std::thread([]
+            {
+                std::vector<void*> blocks;
+
+                for (int index{}; index != 16; ++index)
+                {
+                    blocks.push_back(heap_block_pool::allocate(3));
+                }
+
+                for (auto&& block : blocks)
+                {
+                    heap_block_pool::release(block, 3);
+                }
+            }).join();
+
+        std::thread([]
+            {
+                auto const allocations = heap_allocations.load();
+                std::vector<void*> blocks;
+
+                for (int index{}; index != 16; ++index)
+                {
+                    blocks.push_back(heap_block_pool::allocate(3));
+                }
+
+                CHECK(heap_allocations == allocations);
+
+                for (auto&& block : blocks)
+                {
+                    heap_block_pool::release(block, 3);
+                }
+            }).join();
+
+        // Blocks allocated on one thread and released on another, as strings passed between threads are.
+        std::vector<void*> blocks;
+
+        for (int index{}; index != 10'000; ++index)
+        {
+            blocks.push_back(heap_block_pool::allocate(index % heap_block_pool::class_count));
+        }
+
+        std::thread([&]
+            {
+                for (std::size_t index{}; index != blocks.size(); ++index)
+                {
+                    heap_block_pool::release(blocks[index], index % heap_block_pool::class_count);
+                }
+            }).join();
+
+        // The shared list is bounded, so most of those blocks were returned to the heap.
+        CHECK(heap_allocations - heap_frees < 4 * (4096 + 64) + 64);
+    }
+
+    using winrt::impl::hstring_header;
+    using winrt::impl::shared_hstring_header;
+
+    // Makes a string as code built without the pool would, in a heap block of the given size.
+    shared_hstring_header* make_foreign(std::size_t const bytes, std::uint32_t const padding1, std::uint32_t const padding2)
+    {
+        auto const header = static_cast<shared_hstring_header*>(WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, bytes));
+        header->flags = 0;
+        header->length = 1;
+        header->padding1 = padding1;
+        header->padding2 = padding2;
+        header->ptr = header->buffer;
+        header->count = 1;
+        header->buffer[0] = L'x';
+        header->buffer[1] = 0;
+        return header;
+    }
+
+    // Returns whether release_hstring handed the last reference to the string back to the heap rather than the pool.
+    bool released_to_heap(hstring_header* const handle)
+    {
+        auto const frees = heap_frees.load();
+        winrt::impl::release_hstring(handle);
+        return heap_frees != frees;
+    }
+
+    void test_strings()
+    {
+        using winrt::impl::hstring_pool_tag;
+
+        // Short strings are tagged with their class and go back to the pool, untagged, when released.
+        auto const pooled = winrt::impl::create_hstring_on_heap(L"pooled", 6);
+        CHECK(pooled->padding1 == hstring_pool_tag);
+        CHECK(pooled->padding2 == heap_block_pool::get_class(sizeof(shared_hstring_header) + 6 * sizeof(wchar_t)));
+        ++static_cast<shared_hstring_header*>(pooled)->count;
+        CHECK(!released_to_heap(pooled));
+        CHECK(!released_to_heap(pooled));
+        CHECK(pooled->padding1 == 0);
+
+        auto const allocations = heap_allocations.load();
+        auto const reused = winrt::impl::create_hstring_on_heap(L"reused", 6);
+        CHECK(reused == pooled);
+        CHECK(heap_allocations == allocations);
+        CHECK(!released_to_heap(reused));
+
+        // Long strings are neither tagged nor pooled.
+        std::vector<wchar_t> text(400, L'x');
+        auto const long_string = winrt::impl::create_hstring_on_heap(text.data(), static_cast<std::uint32_t>(text.size()));
+        CHECK(long_string->padding1 != hstring_pool_tag);
+        CHECK(released_to_heap(long_string));
+
+        // Strings from code built without the pool go back to the heap, whatever their padding fields hold, unless
+        // the heap confirms the block is as large as the class the tag names.
+        CHECK(released_to_heap(make_foreign(heap_block_pool::class_size(1), 0, 1)));
+        CHECK(released_to_heap(make_foreign(heap_block_pool::class_size(1), 0x12345678, 1)));
+        CHECK(released_to_heap(make_foreign(heap_block_pool::class_size(1) - 1, hstring_pool_tag, 1)));
+        CHECK(released_to_heap(make_foreign(sizeof(shared_hstring_header) + sizeof(wchar_t), hstring_pool_tag, 0)));
+        CHECK(released_to_heap(make_foreign(heap_block_pool::class_size(3), hstring_pool_tag, heap_block_pool::class_count)));
+        CHECK(!released_to_heap(make_foreign(heap_block_pool::class_size(2), hstring_pool_tag, 1)));
+    }
+
+    // Returns the number of blocks allocated and released per second by the given number of threads, each keeping a
+    // few dozen blocks alive at a time.
+    double blocks_per_second(bool const pooled, std::size_t const threads)
+    {
+        constexpr std::size_t rounds{ 2'000 };
+        constexpr std::size_t live{ 32 };
+        std::vector<std::thread> workers;
+        auto const start = std::chrono::steady_clock::now();
+
+        for (std::size_t thread{}; thread != threads; ++thread)
+        {
+            workers.emplace_back([pooled, thread]
+                {
+                    auto const sizes = make_sizes(static_cast<std::uint32_t>(thread));
+                    void* blocks[live]{};
+                    std::size_t next{};
+
+                    for (std::size_t round{}; round != rounds; ++round)
+                    {
+                        for (std::size_t index{}; index != live; ++index)
+                        {
+                            blocks[index] = allocate(pooled, sizes[(next + index) % sizes.size()]);
+                            static_cast<char*>(blocks[index])[0] = 0;
+                        }
+
+                        for (std::size_t index{}; index != live; ++index)
+                        {
+                            release(pooled, blocks[index], sizes[(next + index) % sizes.size()]);
+                        }
+
+                        next += live;
+                    }
+                });
+        }
+
+        for (auto&& worker : workers)
+        {
+            worker.join();
+        }
+
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(rounds * live * threads) / elapsed.count();
+    }
+}
+
+int main()
+{
+    test_classes();
+    test_reuse();
+    test_threads();
+    test_strings();
+
+    if (failures != 0)
+    {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+
+    std::printf("All checks passed\n");
+    auto const hardware_threads = (std::max)(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t threads = 1; threads <= hardware_threads; threads *= 2)
+    {
+        auto const heap = blocks_per_second(false, threads);
+        auto const pool = blocks_per_second(true, threads);
+        std::printf("threads %zu: heap %.0f/s, pool %.0f/s\n", threads, heap, pool);
+    }
+}
@@ -0,0 +1,999 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include "cmd_reader.h"
+#include "winmd_writer.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <psapi.h>
+#else
+#include <cerrno>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace cppwinrt::bench
+{
+    struct usage_exception {};
+
+    static constexpr option options[]
+    {
+        { "cppwinrt", 0, 1, "<path>", "Path of the cppwinrt executable to measure" },
+        { "output", 0, 1, "<path>", "File to write the JSON results to (defaults to standard output)" },
+        { "work", 0, 1, "<path>", "Scratch folder for generated metadata and projections (defaults to bench_work)" },
+        { "namespaces", 0, 1, "<count>", "Number of synthetic namespaces (defaults to 50)" },
+        { "interfaces", 0, 1, "<count>", "Number of interfaces per synthetic namespace (defaults to 20)" },
+        { "classes", 0, 1, "<count>", "Number of runtime classes per synthetic namespace (defaults to 8)" },
+        { "depth", 0, 1, "<count>", "Depth of the synthetic class hierarchies (defaults to 4)" },
+        { "cycle", 0, 1, "<count>", "Size of the rings of mutually dependent namespaces (defaults to 4; 0 disables)" },
+        { "iterations", 0, 1, "<count>", "Number of times each scenario is run (defaults to 3)" },
+        { "input", 0, option::no_max, "<spec>", "Real Windows metadata to benchmark in addition to the synthetic metadata" },
+        { "reference", 0, option::no_max, "<spec>", "Windows metadata referenced by the real metadata" },
+        { "compiler", 0, 1, "<path>", "Clang to measure compiling against the synthetic projection with (skipped if not given)" },
+        { "target", 0, 1, "<triple>", "Target of the compile benchmark (defaults to x86_64-w64-mingw32; 'host' omits it)" },
+        { "std_module", 0, 1, "<path>", "The standard library's std.cppm, needed to benchmark compiling with -modules" },
+        { "units", 0, 1, "<count>", "Number of translation units the compile benchmark compiles (defaults to 4)" },
+        { "help", 0, option::no_max, {}, "Show detailed help" },
+    };
+
+    static void print_usage()
+    {
+        std::printf("cppwinrt-bench -cppwinrt <path> [options...]\n\nOptions:\n\n");
+
+        for (auto&& option : options)
+        {
+            std::printf("  -%-12.*s %-10.*s %.*s\n",
+                static_cast<int>(option.name.size()), option.name.data(),
+                static_cast<int>(option.arg.size()), option.arg.data(),
+                static_cast<int>(option.desc.size()), option.desc.data());
+        }
+    }
+
+    static std::uint32_t get_count(reader const& args, std::string_view const& name, std::uint32_t const default_value)
+    {
+        if (!args.exists(name))
+        {
+            return default_value;
+        }
+
+        auto const value = args.value(name);
+        std::uint32_t count{};
+        auto const [last, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+
+        if (error != std::errc{} || last != value.data() + value.size())
+        {
+            throw_invalid("Option '", std::string{ name }, "' requires a number");
+        }
+
+        return count;
+    }
+
+    struct scale
+    {
+        std::uint32_t namespaces{};
+        std::uint32_t interfaces{};
+        std::uint32_t classes{};
+        std::uint32_t depth{};
+        std::uint32_t cycle{};
+    };
+
+    static guid make_guid(std::string_view const& name)
+    {
+        std::uint64_t first{ 0xcbf29ce484222325 };
+        std::uint64_t second{ 0x84222325cbf29ce4 };
+
+        for (auto c : name)
+        {
+            first = (first ^ static_cast<std::uint8_t>(c)) * 0x100000001b3;
+            second = (second ^ static_cast<std::uint8_t>(c)) * 0x100000001b3;
+        }
+
+        guid result;
+        result.data1 = static_cast<std::uint32_t>(first);
+        result.data2 = static_cast<std::uint16_t>(first >> 32);
+        result.data3 = static_cast<std::uint16_t>(first >> 48);
+
+        for (std::size_t index{}; index != result.data4.size(); ++index)
+        {
+            result.data4[index] = static_cast<std::uint8_t>(second >> (index * 8));
+        }
+
+        return result;
+    }
+
+    static std::string get_namespace(std::uint32_t const index)
+    {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%04u", index);
+        return std::string{ "Bench.Synthetic.N" } + buffer;
+    }
+
+    // Writes a metadata file with the requested number of namespaces. Each namespace has a chain of interfaces that
+    // require one another, with generic-heavy method signatures that reference the previous namespace (and the next
+    // namespace in its ring, creating cycles for the module SCC computation), and runtime classes in hierarchies of
+    // the requested depth.
+    static void write_synthetic_winmd(std::string const& filename, scale const& size)
+    {
+        metadata_writer w{ "Bench.Synthetic" };
+        auto const object = w.add_type_ref("System", "Object");
+        constexpr std::uint16_t abstract_method = method_attributes::Public | method_attributes::Virtual |
+            method_attributes::HideBySig | method_attributes::NewSlot | method_attributes::Abstract;
+        constexpr std::uint32_t interface_flags = type_attributes::Public | type_attributes::Interface |
+            type_attributes::Abstract | type_attributes::WindowsRuntime;
+
+        auto add_generic = [&](std::string_view const& name, std::vector<std::string> params, std::vector<method_definition> methods)
+        {
+            type_definition type;
+            type.flags = interface_flags;
+            type.type_namespace = "Bench.Collections";
+            type.name = name;
+            type.id = make_guid(type.type_namespace + "." + type.name);
+            type.has_guid = true;
+            type.generic_params = std::move(params);
+            type.methods = std::move(methods);
+            return w.add_type_def(std::move(type));
+        };
+
+        auto const vector = add_generic("IVector`1", { "T" },
+        {
+            { "GetAt", abstract_method, signature{}.add(0x20).add_compressed(1).add(element_type::Var).add_compressed(0).add(element_type::U4), { { "index" } } },
+            { "Size", abstract_method, signature{}.add(0x20).add_compressed(0).add(element_type::U4), {} },
+        });
+
+        auto const map = add_generic("IMap`2", { "K", "V" },
+        {
+            { "Lookup", abstract_method, signature{}.add(0x20).add_compressed(1).add(element_type::Var).add_compressed(1).add(element_type::Var).add_compressed(0), { { "key" } } },
+            { "HasKey", abstract_method, signature{}.add(0x20).add_compressed(1).add(element_type::Boolean).add(element_type::Var).add_compressed(0), { { "key" } } },
+        });
+
+        auto const first_row = w.next_type_def().row;
+        auto const types_per_namespace = size.interfaces + size.classes;
+
+        auto interface_token = [&](std::uint32_t const ns, std::uint32_t const index) -> token
+        {
+            return { table::TypeDef, first_row + ns * types_per_namespace + index };
+        };
+
+        auto class_token = [&](std::uint32_t const ns, std::uint32_t const index) -> token
+        {
+            return { table::TypeDef, first_row + ns * types_per_namespace + size.interfaces + index };
+        };
+
+        auto vector_of = [&](signature const& element)
+        {
+            return signature{}.add_generic(vector, 1).add(element);
+        };
+
+        for (std::uint32_t ns{}; ns != size.namespaces; ++ns)
+        {
+            auto const type_namespace = get_namespace(ns);
+            auto const previous = ns == 0 ? ns : ns - 1;
+            auto const ring = size.cycle ? ns - ns % size.cycle : ns;
+            auto const peer = size.cycle ? (std::min)(ring + (ns - ring + 1) % size.cycle, size.namespaces - 1) : ns;
+
+            for (std::uint32_t index{}; index != size.interfaces; ++index)
+            {
+                auto const suffix = std::to_string(index);
+                auto const self = interface_token(ns, index);
+
+                type_definition type;
+                type.flags = interface_flags;
+                type.type_namespace = type_namespace;
+                type.name = "IThing" + suffix;
+                type.id = make_guid(type_namespace + "." + type.name);
+                type.has_guid = true;
+
+                if (index != 0)
+                {
+                    type.interfaces.push_back({ interface_token(ns, index - 1) });
+                }
+
+                if (index % 4 == 3)
+                {
+                    type.interfaces.push_back({ w.add_type_spec(vector_of(signature{}.add_class(interface_token(ns, 0)))) });
+                }
+
+                type.methods.push_back({ "Value" + suffix, abstract_method, signature{}.add(0x20).add_compressed(0).add(element_type::I4), {} });
+
+                type.methods.push_back({ "Update" + suffix, abstract_method,
+                    signature{}.add(0x20).add_compressed(2).add(element_type::Void).add(element_type::String).add(element_type::I4),
+                    { { "name" }, { "value" } } });
+
+                type.methods.push_back({ "Items" + suffix, abstract_method,
+                    signature{}.add(0x20).add_compressed(0).add(vector_of(signature{}.add_class(self))), {} });
+
+                type.methods.push_back({ "Lookup" + suffix, abstract_method,
+                    signature{}.add(0x20).add_compressed(1)
+                        .add_generic(map, 2).add(element_type::String).add(vector_of(signature{}.add_class(interface_token(previous, index))))
+                        .add(vector_of(vector_of(signature{}.add(element_type::I4)))),
+                    { { "keys" } } });
+
+                if (peer != ns)
+                {
+                    type.methods.push_back({ "Peer" + suffix, abstract_method,
+                        signature{}.add(0x20).add_compressed(0).add_class(interface_token(peer, index)), {} });
+                }
+
+                w.add_type_def(std::move(type));
+            }
+
+            for (std::uint32_t index{}; index != size.classes; ++index)
+            {
+                auto const level = size.depth ? index % size.depth : 0;
+
+                type_definition type;
+                type.flags = type_attributes::Public | type_attributes::WindowsRuntime;
+                type.type_namespace = type_namespace;
+                type.name = "Thing" + std::to_string(index);
+                type.extends = level == 0 ? object : class_token(ns, index - 1);
+
+                if (level + 1 == size.depth || index + 1 == size.classes)
+                {
+                    type.flags |= type_attributes::Sealed;
+                }
+
+                if (size.interfaces != 0)
+                {
+                    type.interfaces.push_back({ interface_token(ns, index % size.interfaces), true });
+
+                    if (size.interfaces > 1)
+                    {
+                        type.interfaces.push_back({ interface_token(ns, (index + 1) % size.interfaces) });
+                    }
+                }
+
+                w.add_type_def(std::move(type));
+            }
+        }
+
+        w.save(filename);
+    }
+
+    // Flattens the numbers in a JSON document into "object.key" names. Only the subset of JSON written by the
+    // -timings option is supported.
+    static std::map<std::string, double> parse_timings(std::string const& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::string const text{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        std::map<std::string, double> result;
+        std::vector<std::string> scopes;
+        std::string key;
+        std::size_t position{};
+
+        while (position < text.size())
+        {
+            auto const c = text[position];
+
+            if (c == '"')
+            {
+                auto const end = text.find('"', position + 1);
+
+                if (end == std::string::npos)
+                {
+                    break;
+                }
+
+                auto value = text.substr(position + 1, end - position - 1);
+                position = text.find_first_not_of(" \t\r\n", end + 1);
+
+                if (position != std::string::npos && text[position] == ':')
+                {
+                    key = std::move(value);
+                    ++position;
+                }
+                else
+                {
+                    key.clear();
+                }
+            }
+            else if (c == '{')
+            {
+                if (!key.empty())
+                {
+                    scopes.push_back(scopes.empty() ? key : scopes.back() + "." + key);
+                }
+                else if (position != 0)
+                {
+                    scopes.push_back(scopes.empty() ? std::string{} : scopes.back());
+                }
+
+                key.clear();
+                ++position;
+            }
+            else if (c == '}')
+            {
+                if (!scopes.empty())
+                {
+                    scopes.pop_back();
+                }
+
+                ++position;
+            }
+            else if ((c >= '0' && c <= '9') || c == '-')
+            {
+                double value{};
+                auto const [last, error] = std::from_chars(text.data() + position, text.data() + text.size(), value);
+
+                if (error != std::errc{})
+                {
+                    break;
+                }
+
+                if (!key.empty())
+                {
+                    result[scopes.empty() ? key : scopes.back() + "." + key] = value;
+                    key.clear();
+                }
+
+                position = static_cast<std::size_t>(last - text.data());
+            }
+            else
+            {
+                ++position;
+            }
+        }
+
+        return result;
+    }
+
+    static std::string quote(std::string const& value)
+    {
+        return '"' + value + '"';
+    }
+
+    struct scenario
+    {
+        std::string name;
+        std::vector<std::string> arguments;
+        bool keep_output{};
+    };
+
+    struct scenario_result
+    {
+        std::string name;
+        std::map<std::string, std::vector<double>> values;
+    };
+
+    static scenario_result run_scenario(std::string const& cppwinrt, std::filesystem::path const& work, scenario const& test, std::uint32_t const iterations)
+    {
+        auto const output = work / ("out_" + test.name);
+        auto const timings = work / (test.name + ".json");
+        scenario_result result{ test.name, {} };
+
+        std::string command = quote(cppwinrt);
+
+        for (auto&& argument : test.arguments)
+        {
+            command += ' ';
+            command += quote(argument);
+        }
+
+        command += " -output " + quote(output.string()) + " -timings " + quote(timings.string());
+
+#if defined(_WIN32) || defined(_WIN64)
+        // cmd.exe strips the outer quotes when the command line starts with a quote.
+        command = quote(command);
+#endif
+
+        // Scenarios that keep their output measure a run against an up-to-date projection, so they are primed first.
+        if (test.keep_output)
+        {
+            std::filesystem::remove_all(output);
+
+            if (std::system(command.c_str()) != 0)
+            {
+                throw_invalid("Scenario '", test.name, "' failed: ", command);
+            }
+        }
+
+        for (std::uint32_t iteration{}; iteration != iterations; ++iteration)
+        {
+            if (!test.keep_output)
+            {
+                std::filesystem::remove_all(output);
+            }
+
+            std::filesystem::remove(timings);
+
+            if (std::system(command.c_str()) != 0)
+            {
+                throw_invalid("Scenario '", test.name, "' failed: ", command);
+            }
+
+            for (auto&& [key, value] : parse_timings(timings.string()))
+            {
+                result.values[key].push_back(value);
+            }
+        }
+
+        return result;
+    }
+
+    // The outcome of running a compiler or the generator as a child process, including its peak resident memory.
+    struct process_result
+    {
+        int exit_code{};
+        std::uint64_t microseconds{};
+        std::uint64_t peak_rss_kb{};
+    };
+
+    static process_result run_process(std::vector<std::string> const& arguments)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        process_result result;
+
+#if defined(_WIN32) || defined(_WIN64)
+        std::string command;
+
+        for (auto&& argument : arguments)
+        {
+            command += command.empty() ? "" : " ";
+            command += quote(argument);
+        }
+
+        STARTUPINFOA startup{ sizeof(startup) };
+        PROCESS_INFORMATION process{};
+
+        if (!CreateProcessA(nullptr, command.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &process))
+        {
+            throw_invalid("Failed to start: ", command);
+        }
+
+        WaitForSingleObject(process.hProcess, INFINITE);
+        DWORD exit_code{};
+        GetExitCodeProcess(process.hProcess, &exit_code);
+        PROCESS_MEMORY_COUNTERS memory{ sizeof(memory) };
+        K32GetProcessMemoryInfo(process.hProcess, &memory, sizeof(memory));
+        CloseHandle(process.hThread);
+        CloseHandle(process.hProcess);
+
+        result.exit_code = static_cast<int>(exit_code);
+        result.peak_rss_kb = memory.PeakWorkingSetSize / 1024;
+#else
+        std::vector<char*> argv;
+
+        for (auto&& argument : arguments)
+        {
+            argv.push_back(const_cast<char*>(argument.c_str()));
+        }
+
+        argv.push_back(nullptr);
+        auto const pid = ::fork();
+
+        if (pid == -1)
+        {
+            throw_invalid("Failed to start: ", arguments.front());
+        }
+
+        if (pid == 0)
+        {
+            ::execvp(argv.front(), argv.data());
+            ::_exit(127);
+        }
+
+        int status{};
+        rusage usage{};
+
+        while (::wait4(pid, &status, 0, &usage) == -1)
+        {
+            if (errno != EINTR)
+            {
+                throw_invalid("Failed to wait for: ", arguments.front());
+            }
+        }
+
+        result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+#if defined(__APPLE__)
+        result.peak_rss_kb = static_cast<std::uint64_t>(usage.ru_maxrss) / 1024;
+#else
+        result.peak_rss_kb = static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+
+        result.microseconds = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        return result;
+    }
+
+    static process_result run_checked(std::vector<std::string> const& arguments)
+    {
+        auto result = run_process(arguments);
+
+        if (result.exit_code != 0)
+        {
+            std::string command;
+
+            for (auto&& argument : arguments)
+            {
+                command += ' ' + argument;
+            }
+
+            throw_invalid("Command failed:", command);
+        }
+
+        return result;
+    }
+
+    // Reads the durations that clang's -ftime-trace records for the phases of a compilation, in microseconds.
+    // The "Total ..." events summarize each phase, so only those are read.
+    static std::map<std::string, double> parse_time_trace(std::filesystem::path const& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::string const text{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        std::map<std::string, double> result;
+
+        auto get_total = [&](std::string_view const& name)
+        {
+            auto const position = text.find("\"name\":\"Total " + std::string{ name } + "\"");
+
+            if (position == std::string::npos)
+            {
+                return 0.0;
+            }
+
+            auto const first = text.rfind('{', position);
+            auto const last = text.find('}', position);
+            auto const event = std::string_view{ text }.substr(first, last - first);
+            auto const duration = event.find("\"dur\":");
+
+            if (duration == std::string_view::npos)
+            {
+                return 0.0;
+            }
+
+            double value{};
+            auto const number = event.substr(duration + 6);
+            std::from_chars(number.data(), number.data() + number.size(), value);
+            return value;
+        };
+
+        result["frontend_us"] = get_total("Frontend");
+        result["instantiation_us"] = get_total("InstantiateFunction") + get_total("InstantiateClass");
+        result["backend_us"] = get_total("Backend");
+        return result;
+    }
+
+    // How the compile benchmark builds the generated projection: textual includes, a precompiled header holding the
+    // included namespaces, or the -modules interface units.
+    enum class compile_mode
+    {
+        headers,
+        pch,
+        modules,
+    };
+
+    struct compile_settings
+    {
+        std::string compiler;
+        std::string target;
+        std::string std_module;
+        std::uint32_t units{};
+    };
+
+    static std::vector<std::string> get_compiler_arguments(compile_settings const& compiler, std::filesystem::path const& include)
+    {
+        std::vector<std::string> result{ compiler.compiler, "-std=c++20", "-ftime-trace", "-I", include.string() };
+
+        if (!compiler.target.empty())
+        {
+            result.push_back("--target=" + compiler.target);
+        }
+
+        return result;
+    }
+
+    // The namespaces the translation units use, spread over the synthetic metadata so that they depend on different
+    // amounts of it.
+    static std::vector<std::string> get_unit_namespaces(scale const& size, std::uint32_t const units)
+    {
+        std::vector<std::string> result;
+
+        for (std::uint32_t unit{}; unit != units && size.namespaces != 0; ++unit)
+        {
+            result.push_back(get_namespace(units == 1 ? size.namespaces - 1 : unit * (size.namespaces - 1) / (units - 1)));
+        }
+
+        return result;
+    }
+
+    // Writes a translation unit that calls through each synthetic class in the namespace, so that the consume
+    // methods of its interfaces and of the generic collections they return are instantiated.
+    static void write_unit(std::filesystem::path const& filename, std::string const& ns, scale const& size, compile_mode const mode)
+    {
+        std::ofstream file(filename, std::ios::binary);
+        std::string qualified{ "winrt::" + ns };
+
+        for (std::size_t position{}; (position = qualified.find('.', position)) != std::string::npos;)
+        {
+            qualified.replace(position, 1, "::");
+        }
+
+        if (mode == compile_mode::modules)
+        {
+            file << "import " << ns << ";\n\n";
+        }
+        else
+        {
+            file << "#include \"winrt/" << ns << ".h\"\n\n";
+        }
+
+        file << "int use_" << filename.stem().string() << "()\n{\n    int result{};\n";
+
+        for (std::uint32_t index{}; index != size.classes && size.interfaces != 0; ++index)
+        {
+            auto const method = std::to_string(index % size.interfaces);
+            file << "    if (" << qualified << "::Thing" << index << " value{ nullptr })\n    {\n";
+            file << "        result += value.Value" << method << "();\n";
+            file << "        value.Update" << method << "(L\"name\", result);\n";
+            file << "        result += static_cast<int>(value.Items" << method << "().Size());\n";
+            file << "    }\n";
+        }
+
+        file << "    return result;\n}\n";
+    }
+
+    // Returns the module each interface unit in folder exports, with the modules it imports.
+    static std::map<std::string, std::pair<std::filesystem::path, std::vector<std::string>>> get_interface_units(std::filesystem::path const& folder)
+    {
+        std::map<std::string, std::pair<std::filesystem::path, std::vector<std::string>>> result;
+
+        for (auto&& item : std::filesystem::directory_iterator(folder))
+        {
+            if (item.path().extension() != ".ixx")
+            {
+                continue;
+            }
+
+            std::ifstream file(item.path());
+            std::string line;
+            std::string name;
+            std::vector<std::string> imports;
+
+            auto get_name = [&](std::string_view const& prefix)
+            {
+                auto const end = line.find(';');
+                return line.compare(0, prefix.size(), prefix) == 0 && end != std::string::npos ? line.substr(prefix.size(), end - prefix.size()) : std::string{};
+            };
+
+            while (std::getline(file, line))
+            {
+                if (auto exported = get_name("export module "); !exported.empty())
+                {
+                    name = exported;
+                }
+                else if (auto imported = get_name("import "); !imported.empty())
+                {
+                    imports.push_back(imported);
+                }
+                else if (auto reexported = get_name("export import "); !reexported.empty())
+                {
+                    imports.push_back(reexported);
+                }
+            }
+
+            if (!name.empty())
+            {
+                result[name] = { item.path(), std::move(imports) };
+            }
+        }
+
+        return result;
+    }
+
+    // Builds what the translation units need beforehand: the precompiled header or the module interfaces, adding
+    // their cost to the result under "prepare".
+    static void prepare_compile(compile_settings const& compiler, std::filesystem::path const& folder, std::vector<std::string> const& namespaces,
+        compile_mode const mode, std::map<std::string, double>& values)
+    {
+        double wall{};
+        double frontend{};
+        double peak{};
+        double bytes{};
+
+        auto compile = [&](std::vector<std::string> arguments, std::filesystem::path const& output)
+        {
+            auto const process = run_checked(arguments);
+            wall += static_cast<double>(process.microseconds);
+            peak = (std::max)(peak, static_cast<double>(process.peak_rss_kb));
+            frontend += parse_time_trace(std::filesystem::path{ output }.replace_extension(".json"))["frontend_us"];
+            bytes += static_cast<double>(std::filesystem::file_size(output));
+        };
+
+        if (mode == compile_mode::pch)
+        {
+            auto const header = folder / "pch.h";
+
+            {
+                std::ofstream file(header, std::ios::binary);
+
+                for (auto&& ns : namespaces)
+                {
+                    file << "#include \"winrt/" << ns << ".h\"\n";
+                }
+            }
+
+            auto arguments = get_compiler_arguments(compiler, folder);
+            arguments.insert(arguments.end(), { "-x", "c++-header", header.string(), "-o", (folder / "pch.pch").string() });
+            compile(arguments, folder / "pch.pch");
+        }
+        else if (mode == compile_mode::modules)
+        {
+            auto const modules = folder / "bmi";
+            std::filesystem::create_directories(modules);
+            auto const units = get_interface_units(folder / "winrt");
+            std::set<std::string> built;
+
+            auto precompile = [&](std::string const& name, std::filesystem::path const& source)
+            {
+                auto const output = modules / (name + ".pcm");
+                auto arguments = get_compiler_arguments(compiler, folder);
+                arguments.insert(arguments.end(), { "-fprebuilt-module-path=" + modules.string(), "-Wno-reserved-module-identifier",
+                    "-x", "c++-module", "--precompile", source.string(), "-o", output.string() });
+                compile(arguments, output);
+            };
+
+            precompile("std", compiler.std_module);
+            built.insert("std");
+
+            std::function<void(std::string const&)> build = [&](std::string const& name)
+            {
+                auto const found = units.find(name);
+
+                if (found == units.end() || !built.insert(name).second)
+                {
+                    return;
+                }
+
+                for (auto&& imported : found->second.second)
+                {
+                    build(imported);
+                }
+
+                precompile(name, found->second.first);
+            };
+
+            for (auto&& ns : namespaces)
+            {
+                build(ns);
+            }
+        }
+
+        values["prepare.wall_us"] = wall;
+        values["prepare.frontend_us"] = frontend;
+        values["prepare.peak_rss_kb"] = peak;
+        values["prepare.bytes"] = bytes;
+    }
+
+    // Measures the cost of compiling code against a projection of the synthetic metadata, in one of the ways it can
+    // be consumed. The projection is generated once; each iteration rebuilds the precompiled header or the module
+    // interfaces and then compiles the translation units, summing their times and taking the largest peak memory.
+    static scenario_result run_compile_scenario(std::string const& cppwinrt, compile_settings const& compiler, std::filesystem::path const& work,
+        std::string const& synthetic, scale const& size, compile_mode const mode, std::uint32_t const iterations)
+    {
+        static constexpr std::string_view names[]{ "compile_headers", "compile_pch", "compile_modules" };
+        scenario_result result{ std::string{ names[static_cast<int>(mode)] }, {} };
+        std::fprintf(stderr, "cppwinrt-bench : %s\n", result.name.c_str());
+        auto const folder = work / result.name;
+        std::filesystem::remove_all(folder);
+        std::filesystem::create_directories(folder);
+
+        std::vector<std::string> generate{ cppwinrt, "-input", synthetic, "-base", "-output", folder.string() };
+
+        if (mode == compile_mode::modules)
+        {
+            generate.push_back("-modules");
+        }
+
+        run_checked(generate);
+        auto const namespaces = get_unit_namespaces(size, compiler.units);
+
+        for (std::size_t unit{}; unit != namespaces.size(); ++unit)
+        {
+            write_unit(folder / ("unit" + std::to_string(unit) + ".cpp"), namespaces[unit], size, mode);
+        }
+
+        for (std::uint32_t iteration{}; iteration != iterations; ++iteration)
+        {
+            std::map<std::string, double> values;
+
+            if (mode != compile_mode::headers)
+            {
+                prepare_compile(compiler, folder, namespaces, mode, values);
+            }
+
+            for (std::size_t unit{}; unit != namespaces.size(); ++unit)
+            {
+                auto const name = "unit" + std::to_string(unit);
+                auto arguments = get_compiler_arguments(compiler, folder);
+
+                if (mode == compile_mode::pch)
+                {
+                    arguments.insert(arguments.end(), { "-include-pch", (folder / "pch.pch").string() });
+                }
+                else if (mode == compile_mode::modules)
+                {
+                    arguments.push_back("-fprebuilt-module-path=" + (folder / "bmi").string());
+                }
+
+                arguments.insert(arguments.end(), { "-c", (folder / (name + ".cpp")).string(), "-o", (folder / (name + ".o")).string() });
+                auto const process = run_checked(arguments);
+
+                values["units.wall_us"] += static_cast<double>(process.microseconds);
+                values["units.peak_rss_kb"] = (std::max)(values["units.peak_rss_kb"], static_cast<double>(process.peak_rss_kb));
+
+                for (auto&& [key, value] : parse_time_trace(folder / (name + ".json")))
+                {
+                    values["units." + key] += value;
+                }
+            }
+
+            for (auto&& [key, value] : values)
+            {
+                result.values[key].push_back(value);
+            }
+        }
+
+        return result;
+    }
+
+    static void write_statistic(std::ostream& out, scenario_result const& result, std::string_view const& name, double (*select)(std::vector<double>))
+    {
+        out << "            \"" << name << "\": {";
+        bool first{ true };
+
+        for (auto&& [key, values] : result.values)
+        {
+            out << (first ? "\n" : ",\n") << "                \"" << key << "\": " << static_cast<std::int64_t>(select(values));
+            first = false;
+        }
+
+        out << "\n            }";
+    }
+
+    static void write_results(std::ostream& out, scale const& size, std::uint32_t const iterations, std::vector<scenario_result> const& results)
+    {
+        out << "{\n";
+        out << "    \"scale\": { \"namespaces\": " << size.namespaces << ", \"interfaces\": " << size.interfaces <<
+            ", \"classes\": " << size.classes << ", \"depth\": " << size.depth << ", \"cycle\": " << size.cycle << " },\n";
+        out << "    \"iterations\": " << iterations << ",\n";
+        out << "    \"scenarios\": [";
+
+        for (auto&& result : results)
+        {
+            out << (&result == &results.front() ? "\n" : ",\n") << "        {\n";
+            out << "            \"name\": \"" << result.name << "\",\n";
+
+            write_statistic(out, result, "min", [](std::vector<double> values) { return *std::min_element(values.begin(), values.end()); });
+            out << ",\n";
+            write_statistic(out, result, "median", [](std::vector<double> values)
+            {
+                std::sort(values.begin(), values.end());
+                return values[values.size() / 2];
+            });
+            out << ",\n";
+            write_statistic(out, result, "max", [](std::vector<double> values) { return *std::max_element(values.begin(), values.end()); });
+            out << "\n        }";
+        }
+
+        out << "\n    ]\n}\n";
+    }
+
+    static int run(int const argc, char** argv)
+    {
+        try
+        {
+            reader args{ argc, argv, options };
+
+            if (!args || args.exists("help") || !args.exists("cppwinrt"))
+            {
+                throw usage_exception{};
+            }
+
+            scale const size
+            {
+                get_count(args, "namespaces", 50),
+                get_count(args, "interfaces", 20),
+                get_count(args, "classes", 8),
+                get_count(args, "depth", 4),
+                get_count(args, "cycle", 4),
+            };
+
+            auto const iterations = (std::max)(1u, get_count(args, "iterations", 3));
+            auto const cppwinrt = std::filesystem::absolute(args.value("cppwinrt")).string();
+            std::filesystem::path const work = std::filesystem::absolute(args.value("work", "bench_work"));
+            std::filesystem::create_directories(work);
+
+            auto const synthetic = (work / "Bench.Synthetic.winmd").string();
+            write_synthetic_winmd(synthetic, size);
+
+            std::vector<scenario> scenarios
+            {
+                { "synthetic", { "-input", synthetic } },
+                { "synthetic_unchanged", { "-input", synthetic }, true },
+                { "synthetic_modules", { "-input", synthetic, "-modules" } },
+            };
+
+            if (args.exists("input"))
+            {
+                scenario real{ "real", {} };
+
+                for (auto&& input : args.values("input"))
+                {
+                    real.arguments.insert(real.arguments.end(), { "-input", input });
+                }
+
+                for (auto&& reference : args.values("reference"))
+                {
+                    real.arguments.insert(real.arguments.end(), { "-reference", reference });
+                }
+
+                scenarios.push_back(std::move(real));
+            }
+
+            std::vector<scenario_result> results;
+
+            for (auto&& test : scenarios)
+            {
+                std::fprintf(stderr, "cppwinrt-bench : %s\n", test.name.c_str());
+                results.push_back(run_scenario(cppwinrt, work, test, iterations));
+            }
+
+            if (args.exists("compiler"))
+            {
+                compile_settings const compiler
+                {
+                    args.value("compiler"),
+                    args.value("target", "x86_64-w64-mingw32") == "host" ? std::string{} : args.value("target", "x86_64-w64-mingw32"),
+                    args.exists("std_module") ? std::filesystem::absolute(args.value("std_module")).string() : std::string{},
+                    (std::max)(1u, get_count(args, "units", 4)),
+                };
+
+                std::vector<compile_mode> modes{ compile_mode::headers, compile_mode::pch };
+
+                if (!compiler.std_module.empty())
+                {
+                    modes.push_back(compile_mode::modules);
+                }
+
+                for (auto mode : modes)
+                {
+                    results.push_back(run_compile_scenario(cppwinrt, compiler, work, synthetic, size, mode, iterations));
+                }
+            }
+
+            if (args.exists("output"))
+            {
+                std::ofstream file(args.value("output"));
+                write_results(file, size, iterations, results);
+            }
+            else
+            {
+                write_results(std::cout, size, iterations, results);
+            }
+
+            return 0;
+        }
+        catch (usage_exception const&)
+        {
+            print_usage();
+            return 0;
+        }
+        catch (std::exception const& e)
+        {
+            std::fprintf(stderr, "cppwinrt-bench : error %s\n", e.what());
+            return 1;
+        }
+    }
+}
+
+int main(int const argc, char** argv)
+{
+    return cppwinrt::bench::run(argc, argv);
+}
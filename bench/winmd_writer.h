@@ -0,0 +1,880 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace cppwinrt::bench
+{
+    // Writes a minimal ECMA-335 metadata file (.winmd) containing Windows Runtime interface and class definitions.
+    // Only the tables needed to describe interfaces, runtime classes, generic type definitions and the attributes
+    // that cppwinrt reads are supported.
+    enum class table : std::uint8_t
+    {
+        Module = 0x00,
+        TypeRef = 0x01,
+        TypeDef = 0x02,
+        Field = 0x04,
+        MethodDef = 0x06,
+        Param = 0x08,
+        InterfaceImpl = 0x09,
+        MemberRef = 0x0A,
+        CustomAttribute = 0x0C,
+        TypeSpec = 0x1B,
+        Assembly = 0x20,
+        AssemblyRef = 0x23,
+        GenericParam = 0x2A,
+    };
+
+    // A reference to a row of a table, encoded as a coded index when written.
+    struct token
+    {
+        table type{};
+        std::uint32_t row{};
+    };
+
+    struct guid
+    {
+        std::uint32_t data1{};
+        std::uint16_t data2{};
+        std::uint16_t data3{};
+        std::array<std::uint8_t, 8> data4{};
+    };
+
+    namespace element_type
+    {
+        constexpr std::uint8_t Void = 0x01;
+        constexpr std::uint8_t Boolean = 0x02;
+        constexpr std::uint8_t I4 = 0x08;
+        constexpr std::uint8_t U4 = 0x09;
+        constexpr std::uint8_t String = 0x0E;
+        constexpr std::uint8_t Class = 0x12;
+        constexpr std::uint8_t Var = 0x13;
+        constexpr std::uint8_t GenericInst = 0x15;
+    }
+
+    namespace type_attributes
+    {
+        constexpr std::uint32_t Public = 0x00000001;
+        constexpr std::uint32_t Interface = 0x00000020;
+        constexpr std::uint32_t Abstract = 0x00000080;
+        constexpr std::uint32_t Sealed = 0x00000100;
+        constexpr std::uint32_t WindowsRuntime = 0x00004000;
+    }
+
+    namespace method_attributes
+    {
+        constexpr std::uint16_t Public = 0x0006;
+        constexpr std::uint16_t Virtual = 0x0040;
+        constexpr std::uint16_t HideBySig = 0x0080;
+        constexpr std::uint16_t NewSlot = 0x0100;
+        constexpr std::uint16_t Abstract = 0x0400;
+    }
+
+    namespace param_attributes
+    {
+        constexpr std::uint16_t In = 0x0001;
+    }
+
+    // Builds method and type signatures.
+    struct signature
+    {
+        signature& add(std::uint8_t const value)
+        {
+            bytes.push_back(value);
+            return *this;
+        }
+
+        signature& add_compressed(std::uint32_t const value)
+        {
+            if (value < 0x80)
+            {
+                bytes.push_back(static_cast<std::uint8_t>(value));
+            }
+            else if (value < 0x4000)
+            {
+                bytes.push_back(static_cast<std::uint8_t>(0x80 | (value >> 8)));
+                bytes.push_back(static_cast<std::uint8_t>(value));
+            }
+            else if (value < 0x20000000)
+            {
+                bytes.push_back(static_cast<std::uint8_t>(0xC0 | (value >> 24)));
+                bytes.push_back(static_cast<std::uint8_t>(value >> 16));
+                bytes.push_back(static_cast<std::uint8_t>(value >> 8));
+                bytes.push_back(static_cast<std::uint8_t>(value));
+            }
+            else
+            {
+                throw std::invalid_argument("Compressed value out of range");
+            }
+
+            return *this;
+        }
+
+        // Adds a TypeDefOrRefOrSpecEncoded value.
+        signature& add_type(token const& type)
+        {
+            std::uint32_t tag{};
+
+            switch (type.type)
+            {
+            case table::TypeDef: tag = 0; break;
+            case table::TypeRef: tag = 1; break;
+            case table::TypeSpec: tag = 2; break;
+            default: throw std::invalid_argument("Invalid TypeDefOrRef token");
+            }
+
+            return add_compressed(type.row << 2 | tag);
+        }
+
+        // Adds a reference to a class or interface.
+        signature& add_class(token const& type)
+        {
+            return add(element_type::Class).add_type(type);
+        }
+
+        // Adds the start of a generic instance of an interface; the arguments follow.
+        signature& add_generic(token const& type, std::uint32_t const arguments)
+        {
+            return add(element_type::GenericInst).add(element_type::Class).add_type(type).add_compressed(arguments);
+        }
+
+        signature& add(signature const& other)
+        {
+            bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end());
+            return *this;
+        }
+
+        std::vector<std::uint8_t> bytes;
+    };
+
+    struct param_definition
+    {
+        std::string name;
+        std::uint16_t flags{ param_attributes::In };
+    };
+
+    struct method_definition
+    {
+        std::string name;
+        std::uint16_t flags{};
+        signature blob;
+        std::vector<param_definition> params;
+    };
+
+    struct interface_implementation
+    {
+        token type;
+        bool is_default{};
+    };
+
+    struct type_definition
+    {
+        std::uint32_t flags{};
+        std::string type_namespace;
+        std::string name;
+        token extends;
+        guid id;
+        bool has_guid{};
+        std::vector<std::string> generic_params;
+        std::vector<interface_implementation> interfaces;
+        std::vector<method_definition> methods;
+    };
+
+    struct metadata_writer
+    {
+        explicit metadata_writer(std::string assembly) : m_assembly(std::move(assembly))
+        {
+            m_strings.push_back(0);
+            m_blobs.push_back(0);
+
+            m_mscorlib = 1;
+            m_guid_attribute = add_type_ref("Windows.Foundation.Metadata", "GuidAttribute");
+            m_default_attribute = add_type_ref("Windows.Foundation.Metadata", "DefaultAttribute");
+
+            signature guid_constructor;
+            guid_constructor.add(0x20).add_compressed(11).add(element_type::Void).add(element_type::U4).add(0x07).add(0x07);
+
+            for (int index{}; index != 8; ++index)
+            {
+                guid_constructor.add(0x05);
+            }
+
+            signature default_constructor;
+            default_constructor.add(0x20).add_compressed(0).add(element_type::Void);
+
+            m_guid_constructor = add_member_ref(m_guid_attribute, ".ctor", guid_constructor);
+            m_default_constructor = add_member_ref(m_default_attribute, ".ctor", default_constructor);
+
+            // Row 1 of the TypeDef table is the conventional <Module> pseudo type.
+            type_definition module;
+            module.name = "<Module>";
+            m_type_defs.push_back(std::move(module));
+        }
+
+        token add_type_ref(std::string_view const& type_namespace, std::string_view const& name)
+        {
+            m_type_refs.push_back({ std::string{ type_namespace }, std::string{ name } });
+            return { table::TypeRef, static_cast<std::uint32_t>(m_type_refs.size()) };
+        }
+
+        // Returns the token that the next call to add_type_def will return, so that types can refer to each other.
+        token next_type_def() const noexcept
+        {
+            return { table::TypeDef, static_cast<std::uint32_t>(m_type_defs.size() + 1) };
+        }
+
+        token add_type_def(type_definition type)
+        {
+            m_type_defs.push_back(std::move(type));
+            return { table::TypeDef, static_cast<std::uint32_t>(m_type_defs.size()) };
+        }
+
+        token add_type_spec(signature const& blob)
+        {
+            m_type_specs.push_back(blob);
+            return { table::TypeSpec, static_cast<std::uint32_t>(m_type_specs.size()) };
+        }
+
+        void save(std::string const& filename)
+        {
+            auto const metadata = write_metadata();
+
+            // Layout: headers in the first 0x200 bytes, followed by a single section holding the CLI header and the
+            // metadata. The section is mapped at RVA 0x2000.
+            constexpr std::uint32_t file_alignment = 0x200;
+            constexpr std::uint32_t section_alignment = 0x2000;
+            constexpr std::uint32_t section_rva = 0x2000;
+            constexpr std::uint32_t cli_header_size = 72;
+
+            std::vector<std::uint8_t> section;
+            append(section, cli_header_size);
+            append(section, std::uint16_t{ 2 });
+            append(section, std::uint16_t{ 5 });
+            append(section, section_rva + cli_header_size);
+            append(section, static_cast<std::uint32_t>(metadata.size()));
+            append(section, std::uint32_t{ 1 }); // COMIMAGE_FLAGS_ILONLY
+            section.resize(cli_header_size);
+            section.insert(section.end(), metadata.begin(), metadata.end());
+
+            auto const virtual_size = static_cast<std::uint32_t>(section.size());
+            auto const raw_size = align(virtual_size, file_alignment);
+            section.resize(raw_size);
+
+            std::vector<std::uint8_t> file;
+            append(file, std::uint16_t{ 0x5A4D });
+            file.resize(0x3C);
+            append(file, std::uint32_t{ 0x80 });
+            file.resize(0x80);
+
+            append(file, std::uint32_t{ 0x00004550 });
+            append(file, std::uint16_t{ 0x014C }); // Machine
+            append(file, std::uint16_t{ 1 }); // NumberOfSections
+            append(file, std::uint32_t{}); // TimeDateStamp
+            append(file, std::uint32_t{}); // PointerToSymbolTable
+            append(file, std::uint32_t{}); // NumberOfSymbols
+            append(file, std::uint16_t{ 0xE0 }); // SizeOfOptionalHeader
+            append(file, std::uint16_t{ 0x2102 }); // Characteristics
+
+            append(file, std::uint16_t{ 0x010B }); // Magic (PE32)
+            append(file, std::uint8_t{ 11 });
+            append(file, std::uint8_t{ 0 });
+            append(file, raw_size); // SizeOfCode
+            append(file, std::uint32_t{}); // SizeOfInitializedData
+            append(file, std::uint32_t{}); // SizeOfUninitializedData
+            append(file, std::uint32_t{}); // AddressOfEntryPoint
+            append(file, section_rva); // BaseOfCode
+            append(file, std::uint32_t{}); // BaseOfData
+            append(file, std::uint32_t{ 0x400000 }); // ImageBase
+            append(file, section_alignment);
+            append(file, file_alignment);
+            append(file, std::uint16_t{ 4 }); // MajorOperatingSystemVersion
+            append(file, std::uint16_t{});
+            append(file, std::uint16_t{}); // MajorImageVersion
+            append(file, std::uint16_t{});
+            append(file, std::uint16_t{ 4 }); // MajorSubsystemVersion
+            append(file, std::uint16_t{});
+            append(file, std::uint32_t{}); // Win32VersionValue
+            append(file, section_rva + align(virtual_size, section_alignment)); // SizeOfImage
+            append(file, file_alignment); // SizeOfHeaders
+            append(file, std::uint32_t{}); // CheckSum
+            append(file, std::uint16_t{ 3 }); // Subsystem
+            append(file, std::uint16_t{ 0x8540 }); // DllCharacteristics
+            append(file, std::uint32_t{ 0x100000 }); // SizeOfStackReserve
+            append(file, std::uint32_t{ 0x1000 }); // SizeOfStackCommit
+            append(file, std::uint32_t{ 0x100000 }); // SizeOfHeapReserve
+            append(file, std::uint32_t{ 0x1000 }); // SizeOfHeapCommit
+            append(file, std::uint32_t{}); // LoaderFlags
+            append(file, std::uint32_t{ 16 }); // NumberOfRvaAndSizes
+
+            for (std::uint32_t index{}; index != 16; ++index)
+            {
+                // Only the CLI header directory is present.
+                append(file, index == 14 ? section_rva : 0);
+                append(file, index == 14 ? cli_header_size : 0);
+            }
+
+            char const name[8] = ".text";
+            file.insert(file.end(), name, name + sizeof(name));
+            append(file, virtual_size);
+            append(file, section_rva);
+            append(file, raw_size);
+            append(file, file_alignment); // PointerToRawData
+            append(file, std::uint32_t{}); // PointerToRelocations
+            append(file, std::uint32_t{}); // PointerToLinenumbers
+            append(file, std::uint16_t{}); // NumberOfRelocations
+            append(file, std::uint16_t{}); // NumberOfLinenumbers
+            append(file, std::uint32_t{ 0x60000020 }); // Characteristics
+
+            file.resize(file_alignment);
+            file.insert(file.end(), section.begin(), section.end());
+
+            std::ofstream stream(filename, std::ios::out | std::ios::binary);
+            stream.write(reinterpret_cast<char const*>(file.data()), static_cast<std::streamsize>(file.size()));
+
+            if (!stream)
+            {
+                throw std::runtime_error("Failed to write " + filename);
+            }
+        }
+
+    private:
+
+        struct type_ref
+        {
+            std::string type_namespace;
+            std::string name;
+        };
+
+        struct member_ref
+        {
+            token parent;
+            std::string name;
+            signature blob;
+        };
+
+        struct custom_attribute
+        {
+            token parent;
+            token constructor;
+            std::vector<std::uint8_t> value;
+        };
+
+        struct generic_param
+        {
+            std::uint16_t number{};
+            std::uint32_t owner{};
+            std::string name;
+        };
+
+        template <typename T>
+        static void append(std::vector<std::uint8_t>& buffer, T const value)
+        {
+            static_assert(std::is_integral_v<T>);
+
+            for (std::size_t index{}; index != sizeof(T); ++index)
+            {
+                buffer.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (index * 8)));
+            }
+        }
+
+        static std::uint32_t align(std::uint32_t const value, std::uint32_t const alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        token add_member_ref(token const& parent, std::string_view const& name, signature const& blob)
+        {
+            m_member_refs.push_back({ parent, std::string{ name }, blob });
+            return { table::MemberRef, static_cast<std::uint32_t>(m_member_refs.size()) };
+        }
+
+        std::uint32_t add_string(std::string_view const& value)
+        {
+            if (value.empty())
+            {
+                return 0;
+            }
+
+            auto found = m_string_offsets.find(value);
+
+            if (found != m_string_offsets.end())
+            {
+                return found->second;
+            }
+
+            auto const offset = static_cast<std::uint32_t>(m_strings.size());
+            m_strings.insert(m_strings.end(), value.begin(), value.end());
+            m_strings.push_back(0);
+            m_string_offsets.emplace(value, offset);
+            return offset;
+        }
+
+        std::uint32_t add_blob(std::vector<std::uint8_t> const& value)
+        {
+            auto found = m_blob_offsets.find(value);
+
+            if (found != m_blob_offsets.end())
+            {
+                return found->second;
+            }
+
+            auto const offset = static_cast<std::uint32_t>(m_blobs.size());
+            signature length;
+            length.add_compressed(static_cast<std::uint32_t>(value.size()));
+            m_blobs.insert(m_blobs.end(), length.bytes.begin(), length.bytes.end());
+            m_blobs.insert(m_blobs.end(), value.begin(), value.end());
+            m_blob_offsets.emplace(value, offset);
+            return offset;
+        }
+
+        // Columns are written with the sizes that ECMA-335 II.24.2.6 derives from the heap sizes and row counts.
+        struct table_writer
+        {
+            std::vector<std::uint8_t>& buffer;
+            std::map<table, std::uint32_t> const& rows;
+            bool wide_strings{};
+            bool wide_blobs{};
+
+            void u16(std::uint32_t const value) { append(buffer, static_cast<std::uint16_t>(value)); }
+            void u32(std::uint32_t const value) { append(buffer, value); }
+
+            void variable(std::uint32_t const value, bool const wide)
+            {
+                wide ? u32(value) : u16(value);
+            }
+
+            std::uint32_t row_count(table const type) const
+            {
+                auto found = rows.find(type);
+                return found == rows.end() ? 0 : found->second;
+            }
+
+            void string(std::uint32_t const offset) { variable(offset, wide_strings); }
+            void blob(std::uint32_t const offset) { variable(offset, wide_blobs); }
+            void guid_index(std::uint32_t const index) { u16(index); }
+
+            void index(table const type, std::uint32_t const row)
+            {
+                variable(row, row_count(type) >= 0x10000);
+            }
+
+            // The tables of a coded index, in tag order; unused tags are represented by 0xFF.
+            void coded(std::initializer_list<std::uint8_t> const tables, std::uint32_t const bits, token const& value)
+            {
+                std::uint32_t largest{};
+                std::uint32_t tag{};
+                std::uint32_t position{};
+                bool found{};
+
+                for (auto type : tables)
+                {
+                    if (type != 0xFF)
+                    {
+                        largest = (std::max)(largest, row_count(static_cast<table>(type)));
+
+                        if (value.row != 0 && type == static_cast<std::uint8_t>(value.type))
+                        {
+                            tag = position;
+                            found = true;
+                        }
+                    }
+
+                    ++position;
+                }
+
+                if (value.row != 0 && !found)
+                {
+                    throw std::invalid_argument("Invalid coded index");
+                }
+
+                variable(value.row == 0 ? 0 : value.row << bits | tag, largest >= (1u << (16 - bits)));
+            }
+
+            void type_def_or_ref(token const& value) { coded({ 0x02, 0x01, 0x1B }, 2, value); }
+            void resolution_scope(token const& value) { coded({ 0x00, 0x1A, 0x23, 0x01 }, 2, value); }
+            void member_ref_parent(token const& value) { coded({ 0x02, 0x01, 0x1A, 0x06, 0x1B }, 3, value); }
+            void custom_attribute_type(token const& value) { coded({ 0xFF, 0xFF, 0x06, 0x0A, 0xFF }, 3, value); }
+            void type_or_method_def(token const& value) { coded({ 0x02, 0x06 }, 1, value); }
+
+            void has_custom_attribute(token const& value)
+            {
+                coded({ 0x06, 0x04, 0x01, 0x02, 0x08, 0x09, 0x0A, 0x00, 0x0E, 0x17, 0x14, 0x11, 0x1A, 0x1B, 0x20, 0x23, 0x26, 0x27, 0x28, 0x2A, 0x2C, 0x2B }, 5, value);
+            }
+        };
+
+        static std::uint32_t has_custom_attribute_tag(table const type)
+        {
+            switch (type)
+            {
+            case table::TypeDef: return 3;
+            case table::InterfaceImpl: return 5;
+            default: throw std::invalid_argument("Unsupported custom attribute parent");
+            }
+        }
+
+        std::vector<std::uint8_t> write_metadata()
+        {
+            std::vector<custom_attribute> attributes;
+            std::vector<std::pair<std::uint32_t, token>> interface_impls;
+            std::vector<generic_param> generic_params;
+            std::uint32_t method_count{};
+            std::uint32_t param_count{};
+
+            for (std::uint32_t index{}; index != m_type_defs.size(); ++index)
+            {
+                auto const& type = m_type_defs[index];
+                auto const row = index + 1;
+
+                if (type.has_guid)
+                {
+                    std::vector<std::uint8_t> value{ 0x01, 0x00 };
+                    append(value, type.id.data1);
+                    append(value, type.id.data2);
+                    append(value, type.id.data3);
+                    value.insert(value.end(), type.id.data4.begin(), type.id.data4.end());
+                    value.push_back(0);
+                    value.push_back(0);
+                    attributes.push_back({ { table::TypeDef, row }, m_guid_constructor, std::move(value) });
+                }
+
+                for (auto&& implementation : type.interfaces)
+                {
+                    interface_impls.emplace_back(row, implementation.type);
+
+                    if (implementation.is_default)
+                    {
+                        auto const impl_row = static_cast<std::uint32_t>(interface_impls.size());
+                        attributes.push_back({ { table::InterfaceImpl, impl_row }, m_default_constructor, { 0x01, 0x00, 0x00, 0x00 } });
+                    }
+                }
+
+                for (std::uint16_t number{}; number != type.generic_params.size(); ++number)
+                {
+                    generic_params.push_back({ number, row, type.generic_params[number] });
+                }
+
+                for (auto&& method : type.methods)
+                {
+                    ++method_count;
+                    param_count += static_cast<std::uint32_t>(method.params.size());
+                }
+            }
+
+            // CustomAttribute is sorted by its Parent coded index.
+            std::stable_sort(attributes.begin(), attributes.end(), [](custom_attribute const& left, custom_attribute const& right)
+            {
+                auto key = [](token const& parent) { return parent.row << 5 | has_custom_attribute_tag(parent.type); };
+                return key(left.parent) < key(right.parent);
+            });
+
+            std::map<table, std::uint32_t> rows
+            {
+                { table::Module, 1 },
+                { table::TypeRef, static_cast<std::uint32_t>(m_type_refs.size()) },
+                { table::TypeDef, static_cast<std::uint32_t>(m_type_defs.size()) },
+                { table::MethodDef, method_count },
+                { table::Param, param_count },
+                { table::InterfaceImpl, static_cast<std::uint32_t>(interface_impls.size()) },
+                { table::MemberRef, static_cast<std::uint32_t>(m_member_refs.size()) },
+                { table::CustomAttribute, static_cast<std::uint32_t>(attributes.size()) },
+                { table::TypeSpec, static_cast<std::uint32_t>(m_type_specs.size()) },
+                { table::Assembly, 1 },
+                { table::AssemblyRef, 1 },
+                { table::GenericParam, static_cast<std::uint32_t>(generic_params.size()) },
+            };
+
+            // Intern every string and blob before the heap sizes are fixed.
+            auto const module_name = add_string(m_assembly + ".winmd");
+            auto const assembly_name = add_string(m_assembly);
+            auto const mscorlib_name = add_string("mscorlib");
+
+            for (auto&& type : m_type_refs)
+            {
+                add_string(type.name);
+                add_string(type.type_namespace);
+            }
+
+            for (auto&& type : m_type_defs)
+            {
+                add_string(type.name);
+                add_string(type.type_namespace);
+
+                for (auto&& method : type.methods)
+                {
+                    add_string(method.name);
+                    add_blob(method.blob.bytes);
+
+                    for (auto&& param : method.params)
+                    {
+                        add_string(param.name);
+                    }
+                }
+            }
+
+            for (auto&& member : m_member_refs)
+            {
+                add_string(member.name);
+                add_blob(member.blob.bytes);
+            }
+
+            for (auto&& attribute : attributes)
+            {
+                add_blob(attribute.value);
+            }
+
+            for (auto&& spec : m_type_specs)
+            {
+                add_blob(spec.bytes);
+            }
+
+            for (auto&& param : generic_params)
+            {
+                add_string(param.name);
+            }
+
+            while (m_strings.size() % 4)
+            {
+                m_strings.push_back(0);
+            }
+
+            while (m_blobs.size() % 4)
+            {
+                m_blobs.push_back(0);
+            }
+
+            std::vector<std::uint8_t> tables;
+            table_writer w{ tables, rows, m_strings.size() >= 0x10000, m_blobs.size() >= 0x10000 };
+
+            w.u32(0); // Reserved
+            tables.push_back(2); // MajorVersion
+            tables.push_back(0); // MinorVersion
+            tables.push_back(static_cast<std::uint8_t>((w.wide_strings ? 0x01 : 0) | (w.wide_blobs ? 0x04 : 0)));
+            tables.push_back(1); // Reserved
+
+            std::uint64_t valid{};
+
+            for (auto&& [type, count] : rows)
+            {
+                if (count != 0)
+                {
+                    valid |= std::uint64_t{ 1 } << static_cast<std::uint8_t>(type);
+                }
+            }
+
+            append(tables, valid);
+            append(tables, std::uint64_t{ 0x000016003301FA00 }); // Sorted
+
+            for (auto&& [type, count] : rows)
+            {
+                if (count != 0)
+                {
+                    w.u32(count);
+                }
+            }
+
+            // Module
+            w.u16(0);
+            w.string(module_name);
+            w.guid_index(1);
+            w.guid_index(0);
+            w.guid_index(0);
+
+            for (auto&& type : m_type_refs)
+            {
+                w.resolution_scope({ table::AssemblyRef, m_mscorlib });
+                w.string(add_string(type.name));
+                w.string(add_string(type.type_namespace));
+            }
+
+            std::uint32_t method_list{ 1 };
+
+            for (auto&& type : m_type_defs)
+            {
+                w.u32(type.flags);
+                w.string(add_string(type.name));
+                w.string(add_string(type.type_namespace));
+                w.type_def_or_ref(type.extends);
+                w.index(table::Field, 1);
+                w.index(table::MethodDef, method_list);
+                method_list += static_cast<std::uint32_t>(type.methods.size());
+            }
+
+            std::uint32_t param_list{ 1 };
+
+            for (auto&& type : m_type_defs)
+            {
+                for (auto&& method : type.methods)
+                {
+                    w.u32(0); // RVA
+                    w.u16(0x0003); // ImplFlags (runtime managed)
+                    w.u16(method.flags);
+                    w.string(add_string(method.name));
+                    w.blob(add_blob(method.blob.bytes));
+                    w.index(table::Param, param_list);
+                    param_list += static_cast<std::uint32_t>(method.params.size());
+                }
+            }
+
+            for (auto&& type : m_type_defs)
+            {
+                for (auto&& method : type.methods)
+                {
+                    std::uint16_t sequence{ 1 };
+
+                    for (auto&& param : method.params)
+                    {
+                        w.u16(param.flags);
+                        w.u16(sequence++);
+                        w.string(add_string(param.name));
+                    }
+                }
+            }
+
+            for (auto&& [row, type] : interface_impls)
+            {
+                w.index(table::TypeDef, row);
+                w.type_def_or_ref(type);
+            }
+
+            for (auto&& member : m_member_refs)
+            {
+                w.member_ref_parent(member.parent);
+                w.string(add_string(member.name));
+                w.blob(add_blob(member.blob.bytes));
+            }
+
+            for (auto&& attribute : attributes)
+            {
+                w.has_custom_attribute(attribute.parent);
+                w.custom_attribute_type(attribute.constructor);
+                w.blob(add_blob(attribute.value));
+            }
+
+            for (auto&& spec : m_type_specs)
+            {
+                w.blob(add_blob(spec.bytes));
+            }
+
+            // Assembly
+            w.u32(0x8004); // HashAlgId (SHA1)
+            w.u16(255);
+            w.u16(255);
+            w.u16(255);
+            w.u16(255);
+            w.u32(0x200); // Flags (WindowsRuntime)
+            w.blob(0);
+            w.string(assembly_name);
+            w.string(0);
+
+            // AssemblyRef
+            w.u16(4);
+            w.u16(0);
+            w.u16(0);
+            w.u16(0);
+            w.u32(0);
+            w.blob(0);
+            w.string(mscorlib_name);
+            w.string(0);
+            w.blob(0);
+
+            for (auto&& param : generic_params)
+            {
+                w.u16(param.number);
+                w.u16(0);
+                w.type_or_method_def({ table::TypeDef, param.owner });
+                w.string(add_string(param.name));
+            }
+
+            while (tables.size() % 4)
+            {
+                tables.push_back(0);
+            }
+
+            std::vector<std::uint8_t> guids(16);
+
+            for (std::size_t index{}; index != m_assembly.size(); ++index)
+            {
+                guids[index % 16] ^= static_cast<std::uint8_t>(m_assembly[index]);
+            }
+
+            // Metadata root and stream headers, followed by the streams.
+            std::string_view const version{ "WindowsRuntime 1.4" };
+            auto const version_length = align(static_cast<std::uint32_t>(version.size() + 1), 4);
+
+            struct stream
+            {
+                std::string_view name;
+                std::vector<std::uint8_t> const* data;
+            };
+
+            std::vector<stream> const streams
+            {
+                { "#~", &tables },
+                { "#Strings", &m_strings },
+                { "#Blob", &m_blobs },
+                { "#GUID", &guids },
+            };
+
+            std::uint32_t header_size = 16 + version_length + 4;
+
+            for (auto&& [name, data] : streams)
+            {
+                header_size += 8 + align(static_cast<std::uint32_t>(name.size() + 1), 4);
+            }
+
+            std::vector<std::uint8_t> result;
+            append(result, std::uint32_t{ 0x424A5342 });
+            append(result, std::uint16_t{ 1 });
+            append(result, std::uint16_t{ 1 });
+            append(result, std::uint32_t{});
+            append(result, version_length);
+            result.insert(result.end(), version.begin(), version.end());
+            result.resize(16 + version_length);
+            append(result, std::uint16_t{}); // Flags
+            append(result, static_cast<std::uint16_t>(streams.size()));
+
+            auto offset = header_size;
+
+            for (auto&& [name, data] : streams)
+            {
+                append(result, offset);
+                append(result, static_cast<std::uint32_t>(data->size()));
+                result.insert(result.end(), name.begin(), name.end());
+                result.resize(align(static_cast<std::uint32_t>(result.size() + 1), 4));
+                offset += static_cast<std::uint32_t>(data->size());
+            }
+
+            for (auto&& [name, data] : streams)
+            {
+                result.insert(result.end(), data->begin(), data->end());
+            }
+
+            return result;
+        }
+
+        std::string m_assembly;
+        std::uint32_t m_mscorlib{};
+        token m_guid_attribute;
+        token m_default_attribute;
+        token m_guid_constructor;
+        token m_default_constructor;
+        std::vector<type_ref> m_type_refs;
+        std::vector<type_definition> m_type_defs;
+        std::vector<member_ref> m_member_refs;
+        std::vector<signature> m_type_specs;
+        std::vector<std::uint8_t> m_strings;
+        std::vector<std::uint8_t> m_blobs;
+        std::map<std::string, std::uint32_t, std::less<>> m_string_offsets;
+        std::map<std::vector<std::uint8_t>, std::uint32_t> m_blob_offsets;
+    };
+}
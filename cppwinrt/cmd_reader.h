@@ -448,6 +448,16 @@ namespace cppwinrt
             return result->second.front();
         }
 
+        // Splits a line of text into arguments following the same rules as a command line or response file.
+        static std::vector<std::string> split_command_line(std::string line)
+        {
+            std::size_t argc = 0;
+            std::vector<std::string> argv;
+            parse_command_line(line.data(), argv, &argc);
+            argv.resize(argc);
+            return argv;
+        }
+
         template <typename F>
         auto files(std::string_view const& name, F directory_filter) const
         {
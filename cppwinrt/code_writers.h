@@ -38,7 +38,7 @@ namespace cppwinrt
     static void write_version_assert(writer& w)
     {
         w.write_root_include("base");
-        auto format = R"(static_assert(winrt::check_version(CPPWINRT_VERSION, "%"), "Mismatched C++/WinRT or C++/WinRT Plus headers.");
+        constexpr auto format = R"(static_assert(winrt::check_version(CPPWINRT_VERSION, "%"), "Mismatched C++/WinRT or C++/WinRT Plus headers.");
 #define CPPWINRT_VERSION "%"
 )";
         w.write(format, CPPWINRT_VERSION_STRING, CPPWINRT_VERSION_STRING);
@@ -46,7 +46,7 @@ namespace cppwinrt
 
     static void write_include_guard(writer& w)
     {
-        auto format = R"(#pragma once
+        constexpr auto format = R"(#pragma once
 )";
 
         w.write(format);
@@ -54,7 +54,7 @@ namespace cppwinrt
 
     static void write_endif(writer& w)
     {
-        auto format = R"(#endif
+        constexpr auto format = R"(#endif
 )";
 
         w.write(format);
@@ -82,7 +82,7 @@ namespace cppwinrt
             mangled_name += impl;
         }
 
-        auto format = R"(#ifndef WINRT_%_H
+        constexpr auto format = R"(#ifndef WINRT_%_H
 #define WINRT_%_H
 )";
 
@@ -100,7 +100,7 @@ namespace cppwinrt
     {
         if (is_lean_and_mean)
         {
-            auto format = R"(#ifndef WINRT_LEAN_AND_MEAN
+            constexpr auto format = R"(#ifndef WINRT_LEAN_AND_MEAN
 )";
 
             w.write(format);
@@ -117,7 +117,7 @@ namespace cppwinrt
     // It was used to conditionally include C++20 header files, but it is no longer needed now.
     [[nodiscard]] static finish_with wrap_ifdef(writer& w, std::string_view macro)
     {
-        auto format = R"(#ifdef %
+        constexpr auto format = R"(#ifdef %
 )";
 
         w.write(format, macro);
@@ -175,7 +175,7 @@ namespace cppwinrt
 
     static void write_pch(writer& w)
     {
-        auto format = R"(#include "%"
+        constexpr auto format = R"(#include "%"
 )";
 
         if (!settings.component_pch.empty())
@@ -186,7 +186,7 @@ namespace cppwinrt
 
     static void write_close_namespace(writer& w)
     {
-        auto format = R"(}
+        constexpr auto format = R"(}
 )";
 
         w.write(format);
@@ -194,7 +194,7 @@ namespace cppwinrt
 
     [[nodiscard]] static finish_with wrap_impl_namespace(writer& w)
     {
-        auto format = R"(WINRT_EXPORT extern "C++" namespace winrt::impl
+        constexpr auto format = R"(WINRT_EXPORT extern "C++" namespace winrt::impl
 {
 )";
 
@@ -205,7 +205,7 @@ namespace cppwinrt
 
         [[nodiscard]] static finish_with wrap_impl_namespace_without_export(writer& w)
     {
-        auto format = R"(extern "C++" namespace winrt::impl
+        constexpr auto format = R"(extern "C++" namespace winrt::impl
 {
 )";
 
@@ -225,7 +225,7 @@ namespace cppwinrt
 
     [[nodiscard]] static finish_with wrap_type_namespace(writer& w, std::string_view const& ns)
     {
-        auto format = R"(WINRT_EXPORT extern "C++" namespace winrt::@
+        constexpr auto format = R"(WINRT_EXPORT extern "C++" namespace winrt::@
 {
 )";
 
@@ -236,7 +236,7 @@ namespace cppwinrt
 
     [[nodiscard]] static finish_with wrap_type_namespace_without_export(writer& w, std::string_view const& ns)
     {
-        auto format = R"(extern "C++" namespace winrt::@
+        constexpr auto format = R"(extern "C++" namespace winrt::@
 {
 )";
 
@@ -247,7 +247,7 @@ namespace cppwinrt
 
     static void write_enum_field(writer& w, Field const& field)
     {
-        auto format = R"(        % = %,
+        constexpr auto format = R"(        % = %,
 )";
 
         if (auto constant = field.Constant())
@@ -258,7 +258,7 @@ namespace cppwinrt
 
     static void write_enum(writer& w, TypeDef const& type)
     {
-        auto format = R"(    enum class % : %
+        constexpr auto format = R"(    enum class % : %
     {
 %    };
 )";
@@ -276,7 +276,7 @@ namespace cppwinrt
 
         auto name = type.TypeName();
 
-        auto format = R"(    constexpr auto operator|(% const left, % const right) noexcept
+        constexpr auto format = R"(    constexpr auto operator|(% const left, % const right) noexcept
     {
         return static_cast<%>(impl::to_underlying_type(left) | impl::to_underlying_type(right));
     }
@@ -327,7 +327,7 @@ namespace cppwinrt
     {
         for (auto&& param : params)
         {
-            auto format = R"(
+            constexpr auto format = R"(
         static_assert(impl::has_category_v<%>, "% must be WinRT type.");)";
 
             w.write(format, param, param);
@@ -356,7 +356,7 @@ namespace cppwinrt
 
         if (get_category(type) == category::enum_type)
         {
-            auto format = R"(    enum class % : %;
+            constexpr auto format = R"(    enum class % : %;
 )";
 
             w.write(format, type_name.name, type.FieldList().first.Signature().Type());
@@ -389,14 +389,14 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    struct %;
+            constexpr auto format = R"(    struct %;
 )";
 
             w.write(format, type_name.name);
             return;
         }
 
-        auto format = R"(    template <%> struct WINRT_IMPL_EMPTY_BASES %;
+        constexpr auto format = R"(    template <%> struct WINRT_IMPL_EMPTY_BASES %;
 )";
 
         w.write(format,
@@ -446,14 +446,14 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> struct category<%>{ using type = %; };
+            constexpr auto format = R"(    template <> struct category<%>{ using type = %; };
 )";
 
             w.write(format, type, category);
         }
         else
         {
-            auto format = R"(    template <%> struct category<%>{ using type = generic_category<%>; };
+            constexpr auto format = R"(    template <%> struct category<%>{ using type = generic_category<%>; };
 )";
 
             w.write(format,
@@ -488,14 +488,14 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> inline constexpr auto& name_v<%> = L"%.%";
+            constexpr auto format = R"(    template <> inline constexpr auto& name_v<%> = L"%.%";
 )";
 
             w.write(format, type, type_name.name_space, type_name.name);
         }
         else
         {
-            auto format = R"(    template <%> inline constexpr auto name_v<%> = zcombine(L"%.%<"%, L">");
+            constexpr auto format = R"(    template <%> inline constexpr auto name_v<%> = zcombine(L"%.%<"%, L">");
 )";
 
             w.write(format,
@@ -521,7 +521,7 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> inline constexpr guid guid_v<%>{ % }; // %
+            constexpr auto format = R"(    template <> inline constexpr guid guid_v<%>{ % }; // %
 )";
 
             w.write(format,
@@ -531,7 +531,7 @@ namespace cppwinrt
         }
         else
         {
-            auto format = R"(    template <%> inline constexpr guid guid_v<%>{ pinterface_guid<%>::value };
+            constexpr auto format = R"(    template <%> inline constexpr guid guid_v<%>{ pinterface_guid<%>::value };
     template <%> inline constexpr guid generic_guid_v<%>{ % }; // %
 )";
 
@@ -550,7 +550,7 @@ namespace cppwinrt
     {
         if (auto default_interface = get_default_interface(type))
         {
-            auto format = R"(    template <> struct default_interface<%>{ using type = %; };
+            constexpr auto format = R"(    template <> struct default_interface<%>{ using type = %; };
 )";
             w.write(format, type, default_interface);
         }
@@ -558,7 +558,7 @@ namespace cppwinrt
 
     static void write_struct_category(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <> struct category<%>{ using type = struct_category<%>; };
+        constexpr auto format = R"(    template <> struct category<%>{ using type = struct_category<%>; };
 )";
 
         w.write(format, type, bind_list(", ", type.FieldList()));
@@ -622,7 +622,7 @@ namespace cppwinrt
                     format = "std::uint32_t%, %";
                 }
 
-                w.write(format, bind<write_array_size_name>(param), bind<write_abi_arg_out>(param_signature->Type()));
+                w.write(runtime_format{ format }, bind<write_array_size_name>(param), bind<write_abi_arg_out>(param_signature->Type()));
             }
             else
             {
@@ -780,7 +780,7 @@ namespace cppwinrt
 
         std::for_each(bases.rbegin(), bases.rend(), [&](auto&& base)
         {
-            auto format = R"(            virtual void* __stdcall base_%() noexcept = 0;
+            constexpr auto format = R"(            virtual void* __stdcall base_%() noexcept = 0;
 )";
 
             w.write(format, base.TypeName());
@@ -798,7 +798,7 @@ namespace cppwinrt
                 break;
             }
 
-            auto format = R"(            virtual std::int32_t __stdcall %(%) noexcept = 0;
+            constexpr auto format = R"(            virtual std::int32_t __stdcall %(%) noexcept = 0;
 )";
 
             for (auto&& method : info.type.MethodList())
@@ -816,7 +816,7 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> struct abi<%>
+            constexpr auto format = R"(    template <> struct abi<%>
     {
         struct WINRT_IMPL_ABI_DECL type : inspectable_abi
         {
@@ -826,7 +826,7 @@ namespace cppwinrt
         }
         else
         {
-            auto format = R"(    template <%> struct abi<%>
+            constexpr auto format = R"(    template <%> struct abi<%>
     {
         struct WINRT_IMPL_ABI_DECL type : inspectable_abi
         {
@@ -838,7 +838,7 @@ namespace cppwinrt
         }
 
 
-        auto format = R"(            virtual std::int32_t __stdcall %(%) noexcept = 0;
+        constexpr auto format = R"(            virtual std::int32_t __stdcall %(%) noexcept = 0;
 )";
 
         auto abi_guard = w.push_abi_types(true);
@@ -867,7 +867,7 @@ namespace cppwinrt
 
     static void write_delegate_abi(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <%> struct abi<%>
+        constexpr auto format = R"(    template <%> struct abi<%>
     {
         struct WINRT_IMPL_ABI_DECL type : unknown_abi
         {
@@ -896,7 +896,7 @@ namespace cppwinrt
     {
         auto abi_guard = w.push_abi_types(true);
 
-        auto format = R"(    struct struct_%
+        constexpr auto format = R"(    struct struct_%
     {
 %    };
     template <> struct abi<@::%>
@@ -941,7 +941,7 @@ namespace cppwinrt
                     format = "array_view<%>";
                 }
 
-                w.write(format, param_signature->Type().Type());
+                w.write(runtime_format{ format }, param_signature->Type().Type());
             }
             else
             {
@@ -1005,7 +1005,7 @@ namespace cppwinrt
                     format = "array_view<%>";
                 }
 
-                w.write(format, param_signature->Type().Type());
+                w.write(runtime_format{ format }, param_signature->Type().Type());
             }
             else
             {
@@ -1053,7 +1053,7 @@ namespace cppwinrt
 
         if (is_add_overload(method))
         {
-            auto format = R"(        using %_revoker = impl::event_revoker<%, &impl::abi_t<%>::remove_%>;
+            constexpr auto format = R"(        using %_revoker = impl::event_revoker<%, &impl::abi_t<%>::remove_%>;
         [[nodiscard]] auto %(auto_revoke_t, %) const;
 )";
 
@@ -1103,7 +1103,7 @@ namespace cppwinrt
 
         if (category == param_category::array_type)
         {
-            auto format = R"(
+            constexpr auto format = R"(
         std::uint32_t %_impl_size{};
         %* %{};)";
 
@@ -1117,17 +1117,17 @@ namespace cppwinrt
         }
         else if (category == param_category::object_type || category == param_category::string_type)
         {
-            auto format = "\n        void* %{};";
+            constexpr auto format = "\n        void* %{};";
             w.write(format, signature.return_param_name());
         }
         else if (category == param_category::generic_type)
         {
-            auto format = "\n        % %{ empty_value<%>() };";
+            constexpr auto format = "\n        % %{ empty_value<%>() };";
             w.write(format, signature.return_signature(), signature.return_param_name(), signature.return_signature());
         }
         else
         {
-            auto format = "\n        % %{};";
+            constexpr auto format = "\n        % %{};";
             w.write(format, signature.return_signature(), signature.return_param_name());
         }
     }
@@ -1212,7 +1212,7 @@ namespace cppwinrt
 )";
         }
 
-        w.write(format,
+        w.write(runtime_format{ format },
             bind<write_comma_generic_typenames>(generics),
             type_impl_name,
             bind<write_comma_generic_types>(generics),
@@ -1233,7 +1233,7 @@ namespace cppwinrt
     }
 )";
 
-            w.write(format,
+            w.write(runtime_format{ format },
                 bind<write_comma_generic_typenames>(generics),
                 type_impl_name,
                 bind<write_comma_generic_types>(generics),
@@ -1257,7 +1257,7 @@ namespace cppwinrt
     }
 )";
 
-        w.write(format,
+        w.write(runtime_format{ format },
             class_type.TypeName(),
             method_name,
             bind<write_consume_params>(signature),
@@ -1274,7 +1274,7 @@ namespace cppwinrt
     }
 )";
 
-            w.write(format,
+            w.write(runtime_format{ format },
                 class_type.TypeName(),
                 method_name,
                 bind<write_consume_params>(signature),
@@ -1575,7 +1575,7 @@ namespace cppwinrt
     
         if (empty(generics))
         {
-        auto format = R"(    template <typename D>
+        constexpr auto format = R"(    template <typename D>
     struct consume_%
     {
 %%%    };
@@ -1588,7 +1588,7 @@ namespace cppwinrt
         }
         else
         {
-        auto format = R"(    template <typename D, %>
+        constexpr auto format = R"(    template <typename D, %>
     struct consume_%
     {
 %%%    };
@@ -1618,7 +1618,7 @@ namespace cppwinrt
     
         if (empty(generics))
         {
-        auto format = R"(    template <> struct consume<%>
+        constexpr auto format = R"(    template <> struct consume<%>
     {
         template <typename D> using type = consume_%<D>;
     };
@@ -1627,7 +1627,7 @@ namespace cppwinrt
         }
         else
         {
-        auto format = R"(    template <%> struct consume<%>
+        constexpr auto format = R"(    template <%> struct consume<%>
     {
         template <typename D> using type = consume_%<D, %>;
     };
@@ -1720,7 +1720,7 @@ namespace cppwinrt
 
         if (clear)
         {
-            auto format = R"(            clear_abi(%);
+            constexpr auto format = R"(            clear_abi(%);
 )";
 
             w.write(format, param_name);
@@ -1729,7 +1729,7 @@ namespace cppwinrt
         {
             if (signature.is_szarray())
             {
-                auto format = R"(            zero_abi<%>(%, __%Size);
+                constexpr auto format = R"(            zero_abi<%>(%, __%Size);
 )";
 
                 w.write(format,
@@ -1739,7 +1739,7 @@ namespace cppwinrt
             }
             else
             {
-                auto format = R"(            zero_abi<%>(%);
+                constexpr auto format = R"(            zero_abi<%>(%);
 )";
 
                 w.write(format,
@@ -1749,7 +1749,7 @@ namespace cppwinrt
         }
         else if (optional)
         {
-            auto format = R"(            if (%) *% = nullptr;
+            constexpr auto format = R"(            if (%) *% = nullptr;
             winrt::Windows::Foundation::IInspectable winrt_impl_%;
 )";
 
@@ -1977,7 +1977,7 @@ namespace cppwinrt
         }
         catch (...) { return to_hresult(); }
 )";
-            w.write(format,
+            w.write(runtime_format{ format },
                 get_abi_name(method),
                 bind<write_produce_params>(signature),
                 bind<write_produce_cleanup>(signature), // clear_abi
@@ -1986,7 +1986,7 @@ namespace cppwinrt
         }
         else
         {
-            w.write(format,
+            w.write(runtime_format{ format },
                 get_abi_name(method),
                 bind<write_produce_params>(signature),
                 bind<write_produce_cleanup>(signature),
@@ -2012,7 +2012,7 @@ namespace cppwinrt
 
         std::for_each(bases.rbegin(), bases.rend(), [&](auto && base)
         {
-            auto format = R"(        void* __stdcall base_%() noexcept final
+            constexpr auto format = R"(        void* __stdcall base_%() noexcept final
         {
             return this->shim().base_%();
         }
@@ -2040,7 +2040,7 @@ namespace cppwinrt
 
     static void write_produce(writer& w, TypeDef const& type, cache const& c)
     {
-        auto format = R"(    template <typename D%>
+        constexpr auto format = R"(    template <typename D%>
     struct produce<D, %> : produce_base<D, %>
     {
 %%    };
@@ -2062,7 +2062,7 @@ namespace cppwinrt
 
     static void write_dispatch_overridable_method(writer& w, MethodDef const& method)
     {
-        auto format = R"(    auto %(%)%
+        constexpr auto format = R"(    auto %(%)%
     {
         if (auto overridable = this->shim_overridable())
         {
@@ -2087,7 +2087,7 @@ namespace cppwinrt
 
     static void write_dispatch_overridable(writer& w, TypeDef const& class_type)
     {
-        auto format = R"(template <typename T, typename D>
+        constexpr auto format = R"(template <typename T, typename D>
 struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
     : produce_dispatch_to_overridable_base<T, D, %>
 {
@@ -2108,7 +2108,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
     static void write_interface_override_method(writer& w, MethodDef const& method, std::string_view const& interface_name)
     {
-        auto format = R"(    template <typename D> auto %T<D>::%(%) const%
+        constexpr auto format = R"(    template <typename D> auto %T<D>::%(%) const%
     {
         return shim().template try_as<%>().%(%);
     }
@@ -2256,7 +2256,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
             factory_name = w.write_temp("%", factory);
         }
 
-        auto format = "impl::call_factory<%, %>([&](% const& f)";
+        constexpr auto format = "impl::call_factory<%, %>([&](% const& f)";
 
         w.write(format,
             type.TypeName(),
@@ -2279,7 +2279,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (signature.params().empty())
         {
-            auto format = "impl::call_factory_cast<%(*)(% const&), %, %>([](% const& f) { return f.%(); })";
+            constexpr auto format = "impl::call_factory_cast<%(*)(% const&), %, %>([](% const& f) { return f.%(); })";
 
             w.write(format,
                 signature.return_signature(),
@@ -2291,7 +2291,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         }
         else
         {
-            auto format = "impl::call_factory<%, %>([&](% const& f) { return f.%(%); })";
+            constexpr auto format = "impl::call_factory<%, %>([&](% const& f) { return f.%(%); })";
 
             w.write(format,
                 type.TypeName(),
@@ -2306,7 +2306,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
     {
         auto type_name = type.TypeName();
 
-        auto format = R"(        %T(%)
+        constexpr auto format = R"(        %T(%)
         {
             % { [[maybe_unused]] auto winrt_impl_discarded = f.%(%%*this, this->m_inner); });
         }
@@ -2338,7 +2338,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
     static void write_interface_override(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <typename D>
+        constexpr auto format = R"(    template <typename D>
     class %T
     {
         D& shim() noexcept { return *static_cast<D*>(this); }
@@ -2384,11 +2384,14 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
             for (auto&& [interface_name, info] : interfaces)
             {
-                w.write(info.overridable
-                        ? "        using %T<D>::%;\n"
-                        : "        using impl::consume_t<D, %>::%;\n",
-                    interface_name,
-                    method_name);
+                if (info.overridable)
+                {
+                    w.write("        using %T<D>::%;\n", interface_name, method_name);
+                }
+                else
+                {
+                    w.write("        using impl::consume_t<D, %>::%;\n", interface_name, method_name);
+                }
             }
         }
     }
@@ -2412,7 +2415,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
             return;
         }
 
-        auto format = R"(    template <typename D, typename... Interfaces>
+        constexpr auto format = R"(    template <typename D, typename... Interfaces>
     struct %T :
         implements<D%, composing, Interfaces...>,
         impl::require<D%>%,
@@ -2565,7 +2568,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (empty(generics))
         {
-            auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % :
+            constexpr auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % :
         winrt::Windows::Foundation::IInspectable,
         impl::consume_t<%>%
     {
@@ -2589,7 +2592,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         {
             type_name = remove_tick(type_name);
 
-            auto format = R"(    template <%>
+            constexpr auto format = R"(    template <%>
     struct WINRT_IMPL_EMPTY_BASES % :
         winrt::Windows::Foundation::IInspectable,
         impl::consume_t<%>%
@@ -2624,13 +2627,13 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         {
             type_name = remove_tick(type_name);
 
-            auto format = R"(    template <%>
+            constexpr auto format = R"(    template <%>
 )";
 
             w.write(format, bind<write_generic_typenames>(generics));
         }
 
-        auto format = R"(    struct % : winrt::Windows::Foundation::IUnknown
+        constexpr auto format = R"(    struct % : winrt::Windows::Foundation::IUnknown
     {%
         %(std::nullptr_t = nullptr) noexcept {}
         %(void* ptr, take_ownership_from_abi_t) noexcept : winrt::Windows::Foundation::IUnknown(ptr, take_ownership_from_abi) {}
@@ -2664,7 +2667,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
     static void write_delegate_implementation(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <typename H%> struct delegate<%, H> final : implements_delegate<%, H>
+        constexpr auto format = R"(    template <typename H%> struct delegate<%, H> final : implements_delegate<%, H>
     {
         delegate(H&& handler) : implements_delegate<%, H>(std::forward<H>(handler)) {}
 
@@ -2700,7 +2703,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (!empty(generics))
         {
-            auto format = R"(    template <%> template <typename L> %<%>::%(L handler) :
+            constexpr auto format = R"(    template <%> template <typename L> %<%>::%(L handler) :
         %(impl::make_delegate<%<%>>(std::forward<L>(handler)))
     {
     }
@@ -2790,7 +2793,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         }
         else
         {
-            auto format = R"(    template <typename L> %::%(L handler) :
+            constexpr auto format = R"(    template <typename L> %::%(L handler) :
         %(impl::make_delegate<%>(std::forward<L>(handler)))
     {
     }
@@ -2870,7 +2873,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
     static bool write_structs(writer& w, std::vector<TypeDef> const& types)
     {
-        auto format = R"(    struct %
+        constexpr auto format = R"(    struct %
     {
 %        bool operator==(% const& other) const% = default;
     };
@@ -3048,7 +3051,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
     {
         for (auto&& base : get_bases(type))
         {
-            auto format = R"(        operator impl::producer_ref<%> const() const noexcept;
+            constexpr auto format = R"(        operator impl::producer_ref<%> const() const noexcept;
 )";
 
             w.write(format, base);
@@ -3074,7 +3077,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         for (auto&& base : get_bases(type))
         {
-            auto format = R"(    inline %::operator impl::producer_ref<%> const() const noexcept
+            constexpr auto format = R"(    inline %::operator impl::producer_ref<%> const() const noexcept
     {
         return { (*impl::abi_t_abi_cast(*static_cast<% const*>(this)))->base_%() };
     }
@@ -3141,7 +3144,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         method_signature signature{ method };
 
-        auto format = R"(    inline %::%(%) :
+        constexpr auto format = R"(    inline %::%(%) :
         %(%)
     {
     }
@@ -3165,7 +3168,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto base_param = params.back().first.Name();
         params.pop_back();
 
-        auto format = R"(    inline %::%(%)
+        constexpr auto format = R"(    inline %::%(%)
     {
         winrt::Windows::Foundation::IInspectable %, %;
         *this = % { return f.%(%%%, %); });
@@ -3223,7 +3226,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
             if (is_event)
             {
                 {
-                    auto format = R"(        using %_revoker = impl::factory_event_revoker<%, &impl::abi_t<%>::remove_%>;
+                    constexpr auto format = R"(        using %_revoker = impl::factory_event_revoker<%, &impl::abi_t<%>::remove_%>;
 )";
                     w.write(format,
                         method_name,
@@ -3234,7 +3237,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
                 if (is_opt_type)
                 {
-                    auto format = R"(        [[nodiscard]] static %_revoker %(auto_revoke_t, %);
+                    constexpr auto format = R"(        [[nodiscard]] static %_revoker %(auto_revoke_t, %);
 )";
                     w.write(format,
                         method_name,
@@ -3243,7 +3246,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
                 }
                 else
                 {
-                    auto format = R"(        [[nodiscard]] static auto %(auto_revoke_t, %);
+                    constexpr auto format = R"(        [[nodiscard]] static auto %(auto_revoke_t, %);
 )";
                     w.write(format,
                         method_name,
@@ -3261,7 +3264,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto async_types_guard = w.push_async_types(signature.is_async());
 
         {
-            auto format = R"(    inline auto %::%(%)
+            constexpr auto format = R"(    inline auto %::%(%)
     {
         %%;
     }
@@ -3277,7 +3280,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (is_add_overload(method))
         {
-            auto format = R"(    inline auto %::%(auto_revoke_t, %)
+            constexpr auto format = R"(    inline auto %::%(auto_revoke_t, %)
     {
         auto f = get_activation_factory<%, %>();
         return %::%_revoker{ f, f.%(%) };
@@ -3331,7 +3334,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 )";
                     }
 
-                    w.write(format,
+                    w.write(runtime_format{ format },
                         type_name,
                         type_name,
                         type_name,
@@ -3360,7 +3363,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         auto factories = get_factories(w, type);
 
-        auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%%
+        constexpr auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%%
     {
         %(std::nullptr_t) noexcept {}
         %(void* ptr, take_ownership_from_abi_t) noexcept : %(ptr, take_ownership_from_abi) {}
@@ -3385,7 +3388,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         auto factories = get_factories(w, type);
 
-        auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%
+        constexpr auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%
     {
         %(std::nullptr_t) noexcept {}
         %(void* ptr, take_ownership_from_abi_t) noexcept : %(ptr, take_ownership_from_abi) {}
@@ -3409,7 +3412,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         auto factories = get_factories(w, type);
 
-        auto format = R"(    struct %
+        constexpr auto format = R"(    struct %
     {
         %() = delete;
 %    };
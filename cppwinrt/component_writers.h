@@ -78,14 +78,14 @@ namespace cppwinrt
 
         if (settings.component_opt)
         {
-            auto format = R"(void* winrt_make_%();
+            constexpr auto format = R"(void* winrt_make_%();
 )";
 
             w.write(format, get_impl_name(type.TypeNamespace(), type.TypeName()));
         }
         else
         {
-            auto format = R"(#include "%.h"
+            constexpr auto format = R"(#include "%.h"
 )";
 
             w.write(format, get_component_filename(type));
@@ -105,7 +105,7 @@ namespace cppwinrt
 
         if (settings.component_opt)
         {
-            auto format = R"(
+            constexpr auto format = R"(
     if (name == L"%.%"sv)
     {
         return winrt_make_%();
@@ -119,7 +119,7 @@ namespace cppwinrt
         }
         else
         {
-            auto format = R"(
+            constexpr auto format = R"(
     if (name == L"%.%"sv)
     {
         return winrt::detach_abi(winrt::make<winrt::@::factory_implementation::%>());
@@ -137,7 +137,7 @@ namespace cppwinrt
     static void write_module_g_cpp(writer& w, std::vector<TypeDef> const& classes)
     {
         w.write_root_include("base");
-        auto format = R"(%
+        constexpr auto format = R"(%
 bool __stdcall %_can_unload_now() noexcept
 {
     if (winrt::get_module_lock())
@@ -167,7 +167,7 @@ void* __stdcall %_get_activation_factory([[maybe_unused]] std::wstring_view cons
             return;
         }
 
-        format = R"(
+        constexpr auto exports_format = R"(
 std::int32_t __stdcall WINRT_CanUnloadNow() noexcept
 {
 #ifdef _WRL_MODULE_H_
@@ -203,7 +203,7 @@ std::int32_t __stdcall WINRT_GetActivationFactory(void* classId, void** factory)
 catch (...) { return winrt::to_hresult(); }
 )";
 
-        w.write(format,
+        w.write(exports_format,
             settings.component_lib,
             settings.component_lib);
     }
@@ -253,7 +253,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_composable_forwarder(writer& w, MethodDef const& method)
     {
-        auto format = R"(        auto %(%)
+        constexpr auto format = R"(        auto %(%)
         {
             return impl::composable_factory<T>::template CreateInstance<%>(%);
         }
@@ -274,7 +274,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_constructor_forwarder(writer& w, MethodDef const& method)
     {
-        auto format = R"(        auto %(%)
+        constexpr auto format = R"(        auto %(%)
         {
             return make<T>(%);
         }
@@ -291,7 +291,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_static_forwarder(writer& w, MethodDef const& method)
     {
-        auto format = R"(        auto %(%)
+        constexpr auto format = R"(        auto %(%)
         {
             return T::%(%);
         }
@@ -376,7 +376,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (has_factory_members(w, type))
         {
-            auto format = R"(void* winrt_make_%()
+            constexpr auto format = R"(void* winrt_make_%()
 {
     return winrt::detach_abi(winrt::make<winrt::@::factory_implementation::%>());
 }
@@ -406,7 +406,7 @@ catch (...) { return winrt::to_hresult(); }
             {
                 if (!factory.type)
                 {
-                    auto format = R"(    %::%() :
+                    constexpr auto format = R"(    %::%() :
         %(make<@::implementation::%>())
     {
     }
@@ -425,7 +425,7 @@ catch (...) { return winrt::to_hresult(); }
                     {
                         method_signature signature{ method };
 
-                        auto format = R"(    %::%(%) :
+                        constexpr auto format = R"(    %::%(%) :
         %(make<@::implementation::%>(%))
     {
     }
@@ -450,7 +450,7 @@ catch (...) { return winrt::to_hresult(); }
                     auto& params = signature.params();
                     params.resize(params.size() - 2);
 
-                    auto format = R"(    %::%(%) :
+                    constexpr auto format = R"(    %::%(%) :
         %(make<@::implementation::%>(%))
     {
     }
@@ -476,7 +476,7 @@ catch (...) { return winrt::to_hresult(); }
 
                     if (is_add_overload(method) || is_remove_overload(method))
                     {
-                        auto format = R"(    % %::%(%)
+                        constexpr auto format = R"(    % %::%(%)
     {
         auto f = make<winrt::@::factory_implementation::%>().as<%>();
         return f.%(%);
@@ -496,7 +496,7 @@ catch (...) { return winrt::to_hresult(); }
                     }
                     else
                     {
-                        auto format = R"(    % %::%(%)
+                        constexpr auto format = R"(    % %::%(%)
     {
         %@::implementation::%::%(%);
     }
@@ -518,7 +518,7 @@ catch (...) { return winrt::to_hresult(); }
 
                     if (is_add_overload(method))
                     {
-                        auto format = R"(    %::%_revoker %::%(auto_revoke_t, %)
+                        constexpr auto format = R"(    %::%_revoker %::%(auto_revoke_t, %)
     {
         auto f = make<winrt::@::factory_implementation::%>().as<%>();
         return %::%_revoker{ f, f.%(%) };
@@ -569,7 +569,7 @@ catch (...) { return winrt::to_hresult(); }
             return;
         }
 
-        auto format = R"(
+        constexpr auto format = R"(
     protected:
         using dispatch = impl::dispatch_to_overridable<D@>;
         auto overridable() noexcept { return dispatch::overridable(static_cast<D&>(*this)); }
@@ -607,7 +607,7 @@ catch (...) { return winrt::to_hresult(); }
                 auto& params = signature.params();
                 params.resize(params.size() - 2);
 
-                auto format = R"(        %_base(%)
+                constexpr auto format = R"(        %_base(%)
         {
             impl::call_factory<%, %>([&](% const& f) { [[maybe_unused]] auto winrt_impl_discarded = f.%(%%*this, this->m_inner); });
         }
@@ -628,7 +628,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_tearoff_interfaces(writer& w, TypeDef const& type)
     {
-        auto format = R"(
+        constexpr auto format = R"(
             if (is_guid_of<%>(id))
             {
                 *result = make_fast_abi_forwarder(static_cast<D const&>(*this).template get_abi<class_type>(), guid_of<%>(), %);
@@ -680,7 +680,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (has_base)
         {
-            auto format = R"(
+            constexpr auto format = R"(
         std::int32_t query_interface_tearoff(guid const& id, void** result) const noexcept override
         {%
             return B::query_interface_tearoff(id, result);
@@ -696,7 +696,7 @@ catch (...) { return winrt::to_hresult(); }
                 return;
             }
 
-            auto format = R"(
+            constexpr auto format = R"(
         std::int32_t query_interface_tearoff(guid const& id, void** result) const noexcept override
         {%
             return impl::error_no_interface;
@@ -721,7 +721,7 @@ catch (...) { return winrt::to_hresult(); }
             return;
         }
 
-        auto format = R"(
+        constexpr auto format = R"(
         auto base_%() const noexcept
         {
             return static_cast<D const&>(*this).template get_abi<%>();
@@ -740,7 +740,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (non_static)
         {
-            auto format = R"(namespace winrt::@::implementation
+            constexpr auto format = R"(namespace winrt::@::implementation
 {
     template <typename D%, typename... I>
     struct WINRT_IMPL_EMPTY_BASES %_base : implements<D, @::%%%, %I...>%%%%
@@ -864,7 +864,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (has_factory_members(w, type))
         {
-            auto format = R"(namespace winrt::@::factory_implementation
+            constexpr auto format = R"(namespace winrt::@::factory_implementation
 {
     template <typename D, typename T, typename... I>
     struct WINRT_IMPL_EMPTY_BASES %T : implements<D, winrt::Windows::Foundation::IActivationFactory%, I...>
@@ -892,7 +892,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (non_static)
         {
-            auto format = R"(
+            constexpr auto format = R"(
 #if defined(WINRT_FORCE_INCLUDE_%_XAML_G_H) || __has_include("%.xaml.g.h")
 
 #ifdef WINRT_CONSUME_MODULE
@@ -1035,7 +1035,7 @@ namespace winrt::@::implementation
 
     static void write_generated_static_assert(writer& w)
     {
-        auto format = R"(
+        constexpr auto format = R"(
 // WARNING: This file is automatically generated by a tool. Do not directly
 // add this file to your project, as any changes you make will be lost.
 // This file is a stub you can use as a starting point for your implementation.
@@ -1072,7 +1072,7 @@ static_assert(false, "This file is generated by a tool and will be overwritten.
         }
 
         {
-            auto format = R"(#include "%.g.h"
+            constexpr auto format = R"(#include "%.g.h"
 %%
 namespace winrt::@::implementation
 {
@@ -1098,7 +1098,7 @@ namespace winrt::@::implementation
 
         if (has_factory_members(w, type))
         {
-            auto format = R"(namespace winrt::@::factory_implementation
+            constexpr auto format = R"(namespace winrt::@::factory_implementation
 {
     struct % : %T<%, implementation::%>
     {
@@ -1127,7 +1127,7 @@ namespace winrt::@::implementation
                     continue;
                 }
 
-                auto format = R"(    %::%(%)
+                constexpr auto format = R"(    %::%(%)
     {
         throw hresult_not_implemented();
     }
@@ -1156,7 +1156,7 @@ namespace winrt::@::implementation
             }
             else if (factory.statics)
             {
-                auto format = R"(    % %::%(%)%
+                constexpr auto format = R"(    % %::%(%)%
     {
         throw hresult_not_implemented();
     }
@@ -1189,7 +1189,7 @@ namespace winrt::@::implementation
 
             for (auto&& method : info.type.MethodList())
             {
-                auto format = R"(    % %::%(%)%
+                constexpr auto format = R"(    % %::%(%)%
     {
         throw hresult_not_implemented();
     }
@@ -1216,7 +1216,7 @@ namespace winrt::@::implementation
         {
             auto filename = get_component_filename(type);
 
-            auto format = R"(#include "%.h"
+            constexpr auto format = R"(#include "%.h"
 )";
 
             w.write(format, filename);
@@ -1226,13 +1226,13 @@ namespace winrt::@::implementation
         {
             auto filename = get_generated_component_filename(type);
 
-            auto format = R"(#include "%.g.cpp"
+            constexpr auto format = R"(#include "%.g.cpp"
 )";
 
             w.write(format, filename);
         }
 
-        auto format = R"(%
+        constexpr auto format = R"(%
 namespace winrt::@::implementation
 {
 %}
@@ -1248,7 +1248,7 @@ namespace winrt::@::implementation
     {
         for (std::uint32_t slot = 6; slot < 1024; ++slot)
         {
-            auto format = R"(    extern "C" void __stdcall winrt_ff_thunk%();
+            constexpr auto format = R"(    extern "C" void __stdcall winrt_ff_thunk%();
 )";
 
             w.write(format, slot);
@@ -1259,7 +1259,7 @@ namespace winrt::@::implementation
     {
         for (std::uint32_t slot = 6; slot < 1024; ++slot)
         {
-            auto format = R"(
+            constexpr auto format = R"(
 #if WINRT_FAST_ABI_SIZE > %
             winrt_ff_thunk%,
 #endif
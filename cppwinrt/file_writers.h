@@ -2,36 +2,29 @@
 
 namespace cppwinrt
 {
-    // Computes the set of namespace-modules that a given namespace's generated headers depend on.
-    // c: metadata cache, used to validate that a dependency is a projected namespace
+    // Computes the set of namespaces that a given namespace's generated headers depend on.
     // ns: the namespace currently being generated
     // w: a writer after it has populated w.depends while emitting header content
-    // imports: populated with a sorted list of projected namespace strings, used by main.cpp to build the
-    // module import graph
-    static void get_namespace_module_imports(cache const& c, std::string_view const& ns, writer const& w, std::vector<std::string>& imports)
+    // depends: populated with a sorted list of namespace strings, used by main.cpp to build the module import graph
+    // and to record dependencies in the incremental generation manifest
+    static void get_namespace_depends(std::string_view const& ns, writer const& w, std::vector<std::string>& depends)
     {
-        // Computes the module import list for a namespace based on writer.depends.
         // w.depends: namespaces referenced while generating the header body (via writer::add_depends)
-        // Output: unique list of dependent namespaces which are projected (have any projected types)
-        // This list drives module generation in `main.cpp`:
+        // main.cpp unions the dependencies from impl headers and the projection header, then keeps the projected
+        // namespaces (those that have any projected types) as module imports:
         // 1. union dependencies from impl headers and the projection header,
         // 2. compute SCCs to break cycles,
-        // 3. emit import ns; for each dependency in the module interface unit.
-        imports.clear();
+        // 3. emit import ns; for each dependent namespace in the module interface unit.
+        depends.clear();
 
-        for (auto&& depends : w.depends)
+        for (auto&& [namespace_id, types] : w.depends)
         {
-            if (depends.first == ns)
-            {
-                continue;
-            }
-
-            auto found = c.namespaces().find(depends.first);
+            auto const depends_namespace = symbols->namespace_name(namespace_id);
 
-            if (found != c.namespaces().end() && has_projected_types(found->second))
+            if (depends_namespace != ns)
             {
-                // w.depends is a sorted map, so imports remains sorted and duplicate-free.
-                imports.emplace_back(depends.first);
+                // w.depends is a sorted map, so depends remains sorted and duplicate-free.
+                depends.emplace_back(depends_namespace);
             }
         }
     }
@@ -40,7 +33,7 @@ namespace cppwinrt
     {
         writer w;
         write_preamble(w);
-        w.write(strings::base_version_odr, CPPWINRT_VERSION_STRING);
+        w.write(runtime_format{ strings::base_version_odr }, CPPWINRT_VERSION_STRING);
         {
             auto wrap_file_guard = wrap_open_file_guard(w, "BASE");
 
@@ -76,6 +69,7 @@ extern "C++"
             w.write(strings::base_abi);
             w.write(strings::base_windows);
             w.write(strings::base_com_ptr);
+            w.write(strings::base_string_pool);
             w.write(strings::base_string);
             w.write(strings::base_string_input);
             w.write(strings::base_string_operators);
@@ -130,6 +124,7 @@ extern "C++"
 
     static void write_fast_forward_h(std::vector<TypeDef> const& classes)
     {
+        trace_span span{ "component", "write_fast_forward_h" };
         writer w;
         write_preamble(w);
         {
@@ -137,7 +132,7 @@ extern "C++"
 
             auto const fast_abi_size = get_fastabi_size(w, classes);
 
-            w.write(strings::base_fast_forward,
+            w.write(runtime_format{ strings::base_fast_forward },
                 fast_abi_size,
                 fast_abi_size,
                 bind<write_component_fast_abi_thunk>(),
@@ -147,12 +142,13 @@ extern "C++"
         w.flush_to_file(settings.output_folder + "winrt/fast_forward.h");
     }
 
-    static void write_namespace_0_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& module_imports)
+    static void write_namespace_0_h(std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& namespace_depends)
     {
         // Emits $(out)\winrt\impl\<ns>.0.h.
-        // When settings.modules is enabled, also populates module_imports with the set of dependent namespaces
-        // found while writing the header body. main.cpp unions the dependency sets from *.0/*.1/*.2/<ns>.h to
-        // build a module import graph.
+        // Also populates namespace_depends with the set of dependent namespaces found while writing the header body.
+        // main.cpp unions the dependency sets from *.0/*.1/*.2/<ns>.h to build a module import graph and to
+        // record the namespace's dependencies for incremental generation.
+        trace_span span{ "namespace", "write_namespace_0_h", ns };
         writer w;
         w.type_namespace = ns;
 
@@ -202,14 +198,7 @@ extern "C++"
             w.write_each<write_consume_specialization>(members.interfaces);
         }
 
-        if (settings.modules)
-        {
-            get_namespace_module_imports(c, ns, w, module_imports);
-        }
-        else
-        {
-            module_imports.clear();
-        }
+        get_namespace_depends(ns, w, namespace_depends);
         write_close_file_guard(w);
         w.swap();
         write_preamble(w);
@@ -220,18 +209,23 @@ extern "C++"
 
             for (auto&& depends : w.depends)
             {
-                auto wrap_type = wrap_type_namespace(w, depends.first);
-                w.write_each<write_forward>(depends.second);
+                auto wrap_type = wrap_type_namespace(w, symbols->namespace_name(depends.first));
+
+                for (auto id : depends.second)
+                {
+                    write_forward(w, symbols->type(id));
+                }
             }
         }
 
         w.save_header('0');
     }
 
-    static void write_namespace_1_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& module_imports)
+    static void write_namespace_1_h(std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& namespace_depends)
     {
         // Emits $(out)\winrt\impl\<ns>.1.h.
-        // Populates module_imports when settings.modules is enabled. See write_namespace_0_h.
+        // Populates namespace_depends. See write_namespace_0_h.
+        trace_span span{ "namespace", "write_namespace_1_h", ns };
         writer w;
         w.type_namespace = ns;
 
@@ -241,14 +235,7 @@ extern "C++"
         }
         write_namespace_special_1(w, ns);
 
-        if (settings.modules)
-        {
-            get_namespace_module_imports(c, ns, w, module_imports);
-        }
-        else
-        {
-            module_imports.clear();
-        }
+        get_namespace_depends(ns, w, namespace_depends);
 
         write_close_file_guard(w);
         w.swap();
@@ -260,7 +247,7 @@ extern "C++"
 
             for (auto&& depends : w.depends)
             {
-                w.write_depends(depends.first, '0');
+                w.write_depends(symbols->namespace_name(depends.first), '0');
             }
 
             w.write_depends(w.type_namespace, '0');
@@ -269,10 +256,11 @@ extern "C++"
         w.save_header('1');
     }
 
-    static void write_namespace_2_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& module_imports)
+    static void write_namespace_2_h(std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& namespace_depends)
     {
         // Emits $(out)\winrt\impl\<ns>.2.h
-        // Populates module_imports when settings.modules is enabled. See write_namespace_0_h.
+        // Populates namespace_depends. See write_namespace_0_h.
+        trace_span span{ "namespace", "write_namespace_2_h", ns };
         writer w;
         w.type_namespace = ns;
 
@@ -285,14 +273,7 @@ extern "C++"
             w.write_each<write_interface_override>(members.classes);
         }
 
-        if (settings.modules)
-        {
-            get_namespace_module_imports(c, ns, w, module_imports);
-        }
-        else
-        {
-            module_imports.clear();
-        }
+        get_namespace_depends(ns, w, namespace_depends);
 
         write_close_file_guard(w);
         w.swap();
@@ -306,7 +287,7 @@ extern "C++"
 
             for (auto&& depends : w.depends)
             {
-                w.write_depends(depends.first, impl);
+                w.write_depends(symbols->namespace_name(depends.first), impl);
             }
 
             w.write_depends(w.type_namespace, '1');
@@ -432,6 +413,7 @@ export module winrt.numerics;
         // import dep for each dependent namespace module (projection headers suppress dependent includes).
         // Include the impl headers (*.0/*.1/*.2) then the projection header (<ns>.h). The headers themselves use
         // WINRT_EXPORT (exported in module builds) for their declarations.
+        trace_span span{ "module", "write_namespace_ixx", ns };
         writer w;
         write_preamble(w);
         write_module_global_fragment(w);
@@ -488,6 +470,7 @@ export import winrt.base;
         // Used when ns is part of a strongly-connected component (cycle) whose declarations are provided by an SCC
         // owner module. This keeps import ns working even when the implementation is consolidated.
         // Output - $(out)\winrt\<ns>.ixx  (export module <ns>; export import <target>;)
+        trace_span span{ "module", "write_namespace_reexport_ixx", ns };
         writer w;
         write_preamble(w);
 
@@ -527,6 +510,7 @@ export import %;
         // Include impl headers for all SCC namespaces in phase order: all *.0.h, then all *.1.h, then all *.2.h,
         // then all projection headers. This preserves the original header layering while keeping SCC compilation
         // deterministic.
+        trace_span span{ "module", "write_namespace_scc_owner_ixx", owner };
         writer w;
         write_preamble(w);
         write_module_global_fragment(w);
@@ -614,8 +598,300 @@ export import winrt.base;
         w.flush_to_file(filename);
     }
 
-    static void write_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& module_imports)
+    // The types that get their own header with -split types, and the path of that header relative to winrt/,
+    // without its extension. Namespaces with hand-written code (see write_namespace_special) aren't split, as that
+    // code may rely on any of their types.
+    static bool is_split_type(TypeDef const& type)
+    {
+        if (!settings.split_types || is_special_namespace(type.TypeNamespace()))
+        {
+            return false;
+        }
+
+        switch (get_category(type))
+        {
+        case category::interface_type:
+        case category::class_type:
+        case category::enum_type:
+        case category::delegate_type:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Generic types keep their arity, as Foo-1, so that they never share a header with a type of the same name.
+    static std::string get_split_type_header(TypeDef const& type)
+    {
+        std::string result{ type.TypeNamespace() };
+        result += '/';
+        auto const name = type.TypeName();
+        auto const tick = name.rfind('`');
+
+        if (tick == std::string_view::npos)
+        {
+            result += name;
+        }
+        else
+        {
+            result += name.substr(0, tick);
+            result += '-';
+            result += name.substr(tick + 1);
+        }
+
+        return result;
+    }
+
+    // The headers generated for a namespace, as paths relative to the output folder.
+    static std::vector<std::string> get_namespace_headers(std::string_view const& ns, cache::namespace_members const& members)
+    {
+        std::string name{ ns };
+        std::vector<std::string> result{ "winrt/impl/" + name + ".0.h", "winrt/impl/" + name + ".1.h", "winrt/impl/" + name + ".2.h", "winrt/" + name + ".h" };
+
+        for (auto const* types : { &members.interfaces, &members.classes, &members.enums, &members.delegates })
+        {
+            for (auto&& type : *types)
+            {
+                if (is_split_type(type))
+                {
+                    result.push_back("winrt/" + get_split_type_header(type) + ".h");
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // Removes the headers that an earlier run wrote for types that ns no longer has. The folder of a namespace only
+    // ever holds the headers of its own types.
+    static void remove_stale_split_type_headers(std::string_view const& ns, cache::namespace_members const& members)
+    {
+        std::set<path> current;
+
+        for (auto&& header : get_namespace_headers(ns, members))
+        {
+            current.insert(path{ settings.output_folder + header }.filename());
+        }
+
+        std::error_code error;
+        std::vector<path> stale;
+
+        for (auto&& file : directory_iterator{ settings.output_folder + "winrt/" + std::string{ ns }, error })
+        {
+            if (file.path().extension() == ".h" && !current.count(file.path().filename()))
+            {
+                stale.push_back(file.path());
+            }
+        }
+
+        for (auto&& file : stale)
+        {
+            std::filesystem::remove(file, error);
+        }
+    }
+
+    static void write_split_type_depends(writer& w, cache const& c, TypeDef const& type)
+    {
+        // A type's header includes the headers of the types whose definitions its users need: the interfaces it
+        // requires or implements, including those of its base classes, and the interfaces its constructors and
+        // static members call through. As with namespace headers, the types in its signatures only need the
+        // declarations in the impl headers.
+        std::set<TypeDef> types;
+        writer scratch;
+        scratch.type_namespace = w.type_namespace;
+
+        for (auto&& [name, info] : get_interfaces(scratch, type))
+        {
+            types.insert(info.type);
+        }
+
+        if (get_category(type) == category::class_type)
+        {
+            for (auto&& [name, factory] : get_factories(scratch, type))
+            {
+                if (factory.type)
+                {
+                    types.insert(factory.type);
+                }
+            }
+        }
+
+        std::set<std::string> includes;
+
+        for (auto&& depends : types)
+        {
+            auto found = c.namespaces().find(depends.TypeNamespace());
+
+            if (depends == type || found == c.namespaces().end() || !has_projected_types(found->second) || !settings.projection_filter.includes(found->second))
+            {
+                continue;
+            }
+
+            if (is_split_type(depends) && (settings.used_types.empty() || settings.used_types.count(depends)))
+            {
+                includes.insert(get_split_type_header(depends));
+            }
+            else if (depends.TypeNamespace() != w.type_namespace)
+            {
+                includes.emplace(depends.TypeNamespace());
+            }
+        }
+
+        for (auto&& include : includes)
+        {
+            w.write_root_include(include);
+        }
+    }
+
+    static void write_split_type_h(cache const& c, TypeDef const& type, std::vector<std::string>& namespace_depends)
     {
+        // Emits $(out)\winrt\<ns>\<type>.h with the definitions that <ns>.h holds for this type alone.
+        // Populates namespace_depends. See write_namespace_0_h.
+        trace_span span{ "namespace", "write_split_type_h", type.TypeName() };
+        writer w;
+        w.type_namespace = type.TypeNamespace();
+
+        switch (get_category(type))
+        {
+        case category::interface_type:
+        {
+            {
+                auto wrap_impl = wrap_impl_namespace(w);
+                write_consume_definitions(w, type);
+                w.param_names = true;
+                write_produce(w, type, c);
+            }
+            {
+                auto wrap_std = wrap_std_namespace(w);
+
+                {
+                    auto wrap_lean = wrap_lean_and_mean(w);
+                    write_std_hash(w, type);
+                }
+
+                write_std_formatter(w, type);
+            }
+            break;
+        }
+        case category::class_type:
+        {
+            w.param_names = true;
+
+            {
+                auto wrap_impl = wrap_impl_namespace(w);
+                write_dispatch_overridable(w, type);
+            }
+            {
+                auto wrap_type = wrap_type_namespace(w, w.type_namespace);
+                write_class_definitions(w, type);
+                write_fast_class_base_definitions(w, type);
+                write_interface_override_methods(w, type);
+                write_class_override(w, type);
+            }
+            {
+                auto wrap_std = wrap_std_namespace(w);
+
+                {
+                    auto wrap_lean = wrap_lean_and_mean(w);
+                    write_std_hash(w, type);
+                }
+
+                write_std_formatter(w, type);
+            }
+            break;
+        }
+        case category::delegate_type:
+        {
+            w.param_names = true;
+
+            {
+                auto wrap_impl = wrap_impl_namespace(w);
+                write_delegate_implementation(w, type);
+            }
+            {
+                auto wrap_type = wrap_type_namespace(w, w.type_namespace);
+                write_delegate_definition(w, type);
+            }
+            break;
+        }
+        default:
+        {
+            auto wrap_type = wrap_type_namespace(w, w.type_namespace);
+            write_enum_operators(w, type);
+            break;
+        }
+        }
+
+        get_namespace_depends(w.type_namespace, w, namespace_depends);
+
+        write_close_file_guard(w);
+        w.swap();
+        write_preamble(w);
+        write_open_file_guard(w, w.type_namespace + "." + std::string{ remove_tick(type.TypeName()) });
+        write_version_assert(w);
+
+        for (auto&& depends : w.depends)
+        {
+            w.write_depends(symbols->namespace_name(depends.first), '2');
+        }
+
+        w.write_depends(w.type_namespace, '2');
+        write_split_type_depends(w, c, type);
+
+        w.flush_to_file(settings.output_folder + "winrt/" + get_split_type_header(type) + ".h");
+    }
+
+    static void write_split_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& namespace_depends)
+    {
+        // Emits $(out)\winrt\<ns>.h for -split types: a header per type (see write_split_type_h), and a namespace
+        // header that includes all of them, so that code including the namespace header is unaffected.
+        trace_span span{ "namespace", "write_split_namespace_h", ns };
+        std::set<std::string> combined;
+        std::vector<std::string> type_depends;
+        std::vector<TypeDef> types;
+
+        for (auto const* category_types : { &members.interfaces, &members.classes, &members.enums, &members.delegates })
+        {
+            types.insert(types.end(), category_types->begin(), category_types->end());
+        }
+
+        create_directories(path{ settings.output_folder + "winrt/" + std::string{ ns } });
+
+        for (auto&& type : types)
+        {
+            write_split_type_h(c, type, type_depends);
+            combined.insert(type_depends.begin(), type_depends.end());
+        }
+
+        namespace_depends.assign(combined.begin(), combined.end());
+        remove_stale_split_type_headers(ns, members);
+
+        writer w;
+        w.type_namespace = ns;
+        write_preamble(w);
+        write_open_file_guard(w, ns);
+        write_version_assert(w);
+        write_parent_depends(w, c, ns);
+        w.write_depends(w.type_namespace, '2');
+
+        for (auto&& type : types)
+        {
+            w.write_root_include(get_split_type_header(type));
+        }
+
+        write_close_file_guard(w);
+        w.save_header();
+    }
+
+    static void write_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members, std::vector<std::string>& namespace_depends)
+    {
+        if (settings.split_types && !is_special_namespace(ns))
+        {
+            write_split_namespace_h(c, ns, members, namespace_depends);
+            return;
+        }
+
+        trace_span span{ "namespace", "write_namespace_h", ns };
         writer w;
         w.type_namespace = ns;
 
@@ -652,14 +928,7 @@ export import winrt.base;
 
         write_namespace_special(w, ns);
 
-        if (settings.modules)
-        {
-            get_namespace_module_imports(c, ns, w, module_imports);
-        }
-        else
-        {
-            module_imports.clear();
-        }
+        get_namespace_depends(ns, w, namespace_depends);
 
         if (settings.modules)
         {
@@ -684,7 +953,7 @@ export import winrt.base;
 
             for (auto&& depends : w.depends)
             {
-                w.write_depends(depends.first, '2');
+                w.write_depends(symbols->namespace_name(depends.first), '2');
             }
 
             w.write_depends(w.type_namespace, '2');
@@ -695,6 +964,7 @@ export import winrt.base;
 
     static void write_module_g_cpp(std::vector<TypeDef> const& classes)
     {
+        trace_span span{ "component", "write_module_g_cpp" };
         writer w;
         write_preamble(w);
         write_pch(w);
@@ -704,6 +974,7 @@ export import winrt.base;
 
     static void write_component_g_h(TypeDef const& type)
     {
+        trace_span span{ "component", "write_component_g_h", type.TypeName() };
         writer w;
         w.add_depends(type);
         write_component_g_h(w, type);
@@ -720,7 +991,7 @@ export import winrt.base;
             for (auto&& depends : w.depends)
             {
                 std::string import_decl{ "import " };
-                import_decl.append(depends.first);
+                import_decl.append(symbols->namespace_name(depends.first));
                 import_decl.append(";\n");
                 w.write(import_decl);
             }
@@ -730,7 +1001,7 @@ export import winrt.base;
 
         for (auto&& depends : w.depends)
         {
-            w.write_depends(depends.first);
+            w.write_depends(symbols->namespace_name(depends.first));
         }
 
         if (settings.modules)
@@ -747,6 +1018,8 @@ export import winrt.base;
 
     static void write_component_g_cpp(TypeDef const& type)
     {
+        trace_span span{ "component", "write_component_g_cpp", type.TypeName() };
+
         if (!settings.component_opt)
         {
             return;
@@ -765,6 +1038,8 @@ export import winrt.base;
 
     static void write_component_h(TypeDef const& type)
     {
+        trace_span span{ "component", "write_component_h", type.TypeName() };
+
         if (settings.component_folder.empty())
         {
             return;
@@ -785,6 +1060,8 @@ export import winrt.base;
 
     static void write_component_cpp(TypeDef const& type)
     {
+        trace_span span{ "component", "write_component_cpp", type.TypeName() };
+
         if (settings.component_folder.empty())
         {
             return;
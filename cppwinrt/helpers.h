@@ -643,9 +643,8 @@ namespace cppwinrt
         }
     };
 
-    static auto get_interfaces(writer& w, TypeDef const& type)
+    static get_interfaces_t compute_interfaces(writer& w, TypeDef const& type)
     {
-        w.abi_types = false;
         get_interfaces_t result;
         get_interfaces_impl(w, result, false, false, false, {}, type.InterfaceImpl());
 
@@ -736,6 +735,98 @@ namespace cppwinrt
         return result;
     }
 
+    // Caches a result computed for a type, so that the writers that ask for it again (possibly on other threads)
+    // don't repeat the work. The result may contain names formatted by the writer, so the flags that affect type
+    // names are part of the key. The types the computation adds to writer::depends are recorded and added again to
+    // the writer of each later request.
+    template <typename T>
+    struct type_memo
+    {
+        template <typename F>
+        T get(writer& w, TypeDef const& type, F&& compute)
+        {
+            key const k{ symbols->type_id(type), w.abi_types, w.consume_types, w.async_types, w.delegate_types };
+
+            {
+                std::lock_guard lock(m_lock);
+                auto found = m_entries.find(k);
+
+                if (found != m_entries.end())
+                {
+                    add_depends(w, found->second.depends);
+                    return found->second.value;
+                }
+            }
+
+            writer scratch;
+            scratch.abi_types = w.abi_types;
+            scratch.consume_types = w.consume_types;
+            scratch.async_types = w.async_types;
+            scratch.delegate_types = w.delegate_types;
+            entry computed{ compute(scratch), {} };
+
+            for (auto&& [namespace_id, types] : scratch.depends)
+            {
+                computed.depends.insert(computed.depends.end(), types.begin(), types.end());
+            }
+
+            add_depends(w, computed.depends);
+            std::lock_guard lock(m_lock);
+            return m_entries.emplace(k, std::move(computed)).first->second.value;
+        }
+
+    private:
+
+        struct key
+        {
+            std::uint32_t type;
+            bool abi_types;
+            bool consume_types;
+            bool async_types;
+            bool delegate_types;
+
+            auto operator<=>(key const&) const = default;
+        };
+
+        struct entry
+        {
+            T value;
+            std::vector<std::uint32_t> depends;
+        };
+
+        static void add_depends(writer& w, std::vector<std::uint32_t> const& depends)
+        {
+            for (auto id : depends)
+            {
+                w.add_depends(symbols->type(id));
+            }
+        }
+
+        std::mutex m_lock;
+        std::map<key, entry> m_entries;
+    };
+
+    // Set by main.cpp for the duration of a run, and cleared when it ends, so that the memo is shared by all of the
+    // writer tasks of that run only.
+    inline type_memo<get_interfaces_t>* interfaces_memo{};
+
+    static auto get_interfaces(writer& w, TypeDef const& type)
+    {
+        w.abi_types = false;
+
+        // Interface names may refer to the generic parameters on the writer's stack, so only requests made outside
+        // of a generic context can share results.
+        if (!interfaces_memo || !w.generic_param_stack.empty())
+        {
+            return compute_interfaces(w, type);
+        }
+
+        return interfaces_memo->get(w, type, [&](writer& scratch)
+        {
+            return compute_interfaces(scratch, type);
+        });
+    }
+
     static bool implements_interface(TypeDef const& type, std::string_view const& name)
     {
         for (auto&& impl : type.InterfaceImpl())
@@ -815,7 +906,9 @@ namespace cppwinrt
         bool visible{};
     };
 
-    static auto get_factories(writer& w, TypeDef const& type)
+    using get_factories_t = std::map<std::string, factory_info>;
+
+    static get_factories_t compute_factories(writer& w, TypeDef const& type)
     {
         auto get_system_type = [&](auto&& signature) -> TypeDef
         {
@@ -830,7 +923,7 @@ namespace cppwinrt
             return {};
         };
 
-        std::map<std::string, factory_info> result;
+        get_factories_t result;
 
         for (auto&& attribute : type.CustomAttribute())
         {
@@ -886,6 +979,22 @@ namespace cppwinrt
         return result;
     }
 
+    // Set by main.cpp for the duration of a run. See interfaces_memo.
+    inline type_memo<get_factories_t>* factories_memo{};
+
+    static auto get_factories(writer& w, TypeDef const& type)
+    {
+        if (!factories_memo)
+        {
+            return compute_factories(w, type);
+        }
+
+        return factories_memo->get(w, type, [&](writer& scratch)
+        {
+            return compute_factories(scratch, type);
+        });
+    }
+
     enum class param_category
     {
         generic_type,
@@ -1104,6 +1213,24 @@ namespace cppwinrt
         return false;
     }
 
+    // Namespaces whose projection headers include hand-written code (see write_namespace_special).
+    static constexpr std::string_view special_namespaces[]
+    {
+        "Windows.Foundation",
+        "Windows.Foundation.Collections",
+        "Windows.System",
+        "Microsoft.UI.Dispatching",
+        "Windows.UI.Core",
+        "Windows.UI.Xaml.Interop",
+        "Windows.UI.Xaml.Markup",
+        "Microsoft.UI.Xaml.Markup",
+    };
+
+    static bool is_special_namespace(std::string_view const& ns)
+    {
+        return std::find(std::begin(special_namespaces), std::end(special_namespaces), ns) != std::end(special_namespaces);
+    }
+
     static bool has_projected_types(cache::namespace_members const& members)
     {
         return
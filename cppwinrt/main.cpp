@@ -1,14 +1,24 @@
 #include "pch.h"
 #include <algorithm>
+#include <charconv>
 #include <ctime>
 #include <iterator>
+#include <list>
+#include <optional>
 #include "strings.h"
+#include "type_filter.h"
 #include "settings.h"
+#include "symbols.h"
 #include "type_writers.h"
 #include "helpers.h"
 #include "code_writers.h"
 #include "component_writers.h"
 #include "file_writers.h"
+#include "manifest.h"
+#include "usage.h"
+#include "output_cache.h"
+#include "timings.h"
+#include "server.h"
 #include "type_writers.h"
 
 namespace cppwinrt
@@ -43,6 +53,18 @@ namespace cppwinrt
         { "fastabi", 0, 0 }, // Enable support for the Fast ABI
         { "ignore_velocity", 0, 0 }, // Ignore feature staging metadata and always include implementations
         { "synchronous", 0, 0 }, // Instructs cppwinrt to run on a single thread to avoid file system issues in batch builds
+        { "jobs", 0, 1, "<count>", "Maximum number of worker threads (defaults to the number of processors)" },
+        { "incremental", 0, 0, {}, "Skip namespaces whose metadata is unchanged since the previous run" },
+        { "hash_cache", 0, 0, {}, "Remember output file hashes to avoid reading unchanged files back" },
+        { "timings", 0, 1 }, // Write the time taken by each phase as JSON (used by the benchmarks)
+        { "profile", 0, 1, "<path>", "Write a Chrome trace of the time taken by each phase, namespace and file" },
+        { "serve", 0, 1, "<path>", "Run as a server that keeps metadata loaded for invocations using -connect" },
+        { "connect", 0, 1, "<path>", "Forward to the server at <path>, or run normally if there is none" },
+        { "batch", 0, 1, "<file>", "Run each line of <file> as a separate invocation, sharing loaded metadata" },
+        { "cache_dir", 0, 1, "<path>", "Reuse namespace headers generated by earlier runs with the same metadata and options" },
+        { "cache_size", 0, 1, "<megabytes>", "Size limit of the -cache_dir folder (defaults to 4096)" },
+        { "usage", 0, option::no_max, "<file>", "Project only the types named in <file> and the types they depend on" },
+        { "split", 0, 1, "<layout>", "Also write a header per class, interface, enum and delegate (<layout> must be types)" },
     };
 
     static void print_usage(writer& w)
@@ -61,7 +83,7 @@ namespace cppwinrt
             printColumns(w, w.write_temp("-% %", opt.name, opt.arg), opt.desc);
         };
 
-        auto format = R"(
+        constexpr auto format = R"(
 C++/WinRT Plus v%
 Copyright (c) Microsoft Corporation. All rights reserved.
 Copyright (c) 2026 YexuanXiao and the C++/WinRT Plus Project. All rights reserved.
@@ -238,6 +260,22 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
         settings.verbose = args.exists("verbose");
         settings.fastabi = args.exists("fastabi");
         settings.modules = args.exists("modules");
+        settings.incremental = args.exists("incremental");
+
+        if (args.exists("split"))
+        {
+            if (args.value("split") != "types")
+            {
+                throw_invalid("Option 'split' only supports the 'types' layout");
+            }
+
+            if (settings.modules)
+            {
+                throw_invalid("Options 'split' and 'modules' cannot be combined");
+            }
+
+            settings.split_types = true;
+        }
 
         settings.input = args.files("input", database::is_database);
         settings.reference = args.files("reference", database::is_database);
@@ -279,6 +317,11 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
             settings.exclude.insert(exclude);
         }
 
+        for (auto && usage : args.values("usage"))
+        {
+            settings.usage.push_back(usage);
+        }
+
         if (settings.license)
         {
             std::string license_arg = args.value("license");
@@ -358,6 +401,43 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
         }
     }
 
+    static std::uint32_t get_jobs(reader const& args)
+    {
+        if (!args.exists("jobs"))
+        {
+            return 0;
+        }
+
+        auto const value = args.value("jobs");
+        std::uint32_t jobs{};
+        auto const [last, error] = std::from_chars(value.data(), value.data() + value.size(), jobs);
+
+        if (error != std::errc{} || last != value.data() + value.size() || jobs == 0)
+        {
+            throw_invalid("Option 'jobs' requires a positive number of threads");
+        }
+
+        return jobs;
+    }
+
+    static std::uint64_t get_cache_size(reader const& args)
+    {
+        std::uint64_t megabytes{ 4096 };
+
+        if (args.exists("cache_size"))
+        {
+            auto const value = args.value("cache_size");
+            auto const [last, error] = std::from_chars(value.data(), value.data() + value.size(), megabytes);
+
+            if (error != std::errc{} || last != value.data() + value.size() || megabytes == 0)
+            {
+                throw_invalid("Option 'cache_size' requires a positive number of megabytes");
+            }
+        }
+
+        return megabytes * 1024 * 1024;
+    }
+
     static auto get_files_to_cache()
     {
         std::vector<std::string> files;
@@ -386,11 +466,12 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
             }
 
             settings.projection_filter = { include_prefixes, settings.exclude };
-            settings.component_filter = { include_prefixes, settings.exclude };
+            settings.component_filter = settings.projection_filter;
             return;
         }
 
-        std::set<std::string> include;
+        type_filter prefix_filter{ include_prefixes, settings.exclude };
+        std::vector<TypeDef> filtered;
 
         for (auto file : settings.input)
         {
@@ -401,30 +482,15 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
 
             for (auto&& type : db->TypeDef)
             {
-                if (!type.Flags().WindowsRuntime())
+                if (type.Flags().WindowsRuntime() && prefix_filter.includes(type))
                 {
-                    continue;
+                    filtered.push_back(type);
                 }
-
-                std::string full_name{ type.TypeNamespace() };
-                full_name += '.';
-                full_name += type.TypeName();
-                include.insert(full_name);
             }
         }
 
-        winmd::reader::filter prefix_filter{ include_prefixes, settings.exclude };
-        std::set<std::string> filtered;
-        for (auto&& type : include)
-        {
-            if (prefix_filter.includes(type))
-            {
-                filtered.insert(type);
-            }
-        }
-
-        settings.projection_filter = { filtered, {} };
-        settings.component_filter = { filtered, {} };
+        settings.projection_filter = { filtered, std::vector<std::string_view>{} };
+        settings.component_filter = settings.projection_filter;
     }
 
     static void build_fastabi_cache(cache const& c)
@@ -476,90 +542,347 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
         c.remove_type("Windows.Foundation.Numerics", "Vector4");
     }
 
-    [[nodiscard]] static std::vector<std::vector<std::string>> compute_strongly_connected_components(std::map<std::string, std::vector<std::string>> const& graph)
+    static std::vector<std::string> get_module_imports(cache const& c, std::set<std::string> const& depends)
+    {
+        // Only namespaces with projected types have a module to import.
+        std::vector<std::string> imports;
+
+        for (auto&& ns : depends)
+        {
+            auto found = c.namespaces().find(ns);
+
+            if (found != c.namespaces().end() && has_projected_types(found->second))
+            {
+                imports.push_back(ns);
+            }
+        }
+
+        return imports;
+    }
+
+    // The results of writing one projected namespace. Each slot is filled in by the task that writes its namespace
+    // (or copied from the previous manifest when the namespace is reused), so the tasks don't share any state.
+    struct namespace_slot
+    {
+        std::string_view ns;
+        cache::namespace_members const* members{};
+        manifest_entry entry;
+    };
+
+    // Returns the index of the slot for ns, or slots.size() if ns is not projected. The slots are sorted by namespace.
+    static std::uint32_t find_namespace_slot(std::vector<namespace_slot> const& slots, std::string_view const& ns)
     {
-        std::vector<std::string> nodes;
-        nodes.reserve(graph.size());
+        auto found = std::lower_bound(slots.begin(), slots.end(), ns, [](namespace_slot const& slot, std::string_view const& value)
+        {
+            return slot.ns < value;
+        });
 
-        for (auto&& [node, _] : graph)
+        if (found == slots.end() || found->ns != ns)
         {
-            nodes.push_back(node);
+            return static_cast<std::uint32_t>(slots.size());
         }
 
-        std::unordered_map<std::string, int> index;
-        std::unordered_map<std::string, int> lowlink;
-        std::unordered_map<std::string, bool> on_stack;
-        std::vector<std::string> stack;
-        int next_index{};
-        std::vector<std::vector<std::string>> components;
+        return static_cast<std::uint32_t>(found - slots.begin());
+    }
 
-        std::function<void(std::string const&)> strongconnect = [&](std::string const& node)
+    // Tarjan's algorithm over a graph of namespace slot indices, using an explicit stack instead of recursion. Each
+    // component is sorted, so its first element is the lexicographically smallest namespace.
+    [[nodiscard]] static std::vector<std::vector<std::uint32_t>> compute_strongly_connected_components(std::vector<std::vector<std::uint32_t>> const& graph)
+    {
+        constexpr std::uint32_t unvisited = (std::numeric_limits<std::uint32_t>::max)();
+        auto const count = static_cast<std::uint32_t>(graph.size());
+        std::vector<std::uint32_t> index(count, unvisited);
+        std::vector<std::uint32_t> lowlink(count);
+        std::vector<bool> on_stack(count);
+        std::vector<std::uint32_t> stack;
+        std::vector<std::pair<std::uint32_t, std::size_t>> calls;
+        std::uint32_t next_index{};
+        std::vector<std::vector<std::uint32_t>> components;
+
+        auto visit = [&](std::uint32_t const node)
         {
-            index.emplace(node, next_index);
-            lowlink.emplace(node, next_index);
+            index[node] = next_index;
+            lowlink[node] = next_index;
             ++next_index;
-
             stack.push_back(node);
             on_stack[node] = true;
+            calls.emplace_back(node, 0);
+        };
 
-            auto const& deps = graph.at(node);
+        for (std::uint32_t root{}; root != count; ++root)
+        {
+            if (index[root] != unvisited)
+            {
+                continue;
+            }
 
-            for (auto&& dep : deps)
+            visit(root);
+
+            while (!calls.empty())
             {
-                if (graph.find(dep) == graph.end())
+                auto const node = calls.back().first;
+                auto const edge = calls.back().second++;
+
+                if (edge != graph[node].size())
                 {
+                    auto const dep = graph[node][edge];
+
+                    if (index[dep] == unvisited)
+                    {
+                        visit(dep);
+                    }
+                    else if (on_stack[dep])
+                    {
+                        lowlink[node] = (std::min)(lowlink[node], index[dep]);
+                    }
+
                     continue;
                 }
 
-                if (index.find(dep) == index.end())
+                calls.pop_back();
+
+                if (!calls.empty())
+                {
+                    auto const parent = calls.back().first;
+                    lowlink[parent] = (std::min)(lowlink[parent], lowlink[node]);
+                }
+
+                if (lowlink[node] != index[node])
                 {
-                    strongconnect(dep);
-                    lowlink[node] = (std::min)(lowlink[node], lowlink[dep]);
+                    continue;
                 }
-                else if (on_stack[dep])
+
+                std::vector<std::uint32_t> component;
+
+                while (true)
                 {
-                    lowlink[node] = (std::min)(lowlink[node], index[dep]);
+                    auto const current = stack.back();
+                    stack.pop_back();
+                    on_stack[current] = false;
+                    component.push_back(current);
+
+                    if (current == node)
+                    {
+                        break;
+                    }
                 }
+
+                std::sort(component.begin(), component.end());
+                components.push_back(std::move(component));
             }
+        }
+
+        return components;
+    }
+
+    // Fingerprints the files to load by path, size and last write time, so that a server only reuses metadata it
+    // loaded from the same, unchanged files.
+    static std::uint64_t get_files_fingerprint(std::vector<std::string> const& files)
+    {
+        fingerprint result;
+
+        for (auto&& file : files)
+        {
+            result.add(file);
+            result.add(static_cast<std::uint64_t>(std::filesystem::file_size(file)));
+            result.add(static_cast<std::uint64_t>(std::filesystem::last_write_time(file).time_since_epoch().count()));
+        }
+
+        return result.value;
+    }
 
-            if (lowlink[node] != index[node])
+    // Fingerprints the options that build_filters depends on, other than the metadata itself.
+    static std::uint64_t get_filters_fingerprint()
+    {
+        fingerprint result;
+        result.add(settings.reference.empty());
+
+        for (auto const* values : { &settings.input, &settings.include, &settings.exclude })
+        {
+            result.add(values->size());
+
+            for (auto&& value : *values)
+            {
+                result.add(value);
+            }
+        }
+
+        return result.value;
+    }
+
+    // The metadata loaded for a run, along with the filters and fast ABI cache derived from it. A server keeps these
+    // between requests, so the derived data is kept here too and only rebuilt when the options it depends on change.
+    struct loaded_metadata
+    {
+        // The time taken to load and index one metadata file, reported by -verbose.
+        struct database_load
+        {
+            std::string file;
+            std::uint64_t microseconds{};
+        };
+
+        // The databases are added one at a time, rather than by the cache's constructor, so that each can be timed.
+        // The cache indexes every database into namespace maps shared by all of them, and only builds databases
+        // itself, so they can't be loaded on the pool.
+        explicit loaded_metadata(std::vector<std::string> const& files) :
+            c{ std::vector<std::string>{}, is_windows_runtime_type }
+        {
+            for (auto&& file : files)
+            {
+                trace_span span{ "load", "add_database", file };
+                auto const start = std::chrono::steady_clock::now();
+                c.add_database(file, is_windows_runtime_type);
+                loads.push_back({ file, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()) });
+            }
+
+            remove_foundation_types(c);
+            table.emplace(c);
+        }
+
+        void apply_filters()
+        {
+            auto const key = get_filters_fingerprint();
+
+            if (filters_key != key)
+            {
+                build_filters(c);
+                filters_key = key;
+                projection_filter = settings.projection_filter;
+                component_filter = settings.component_filter;
+            }
+            else
+            {
+                settings.projection_filter = projection_filter;
+                settings.component_filter = component_filter;
+            }
+        }
+
+        void apply_fastabi_cache()
+        {
+            if (!settings.fastabi)
             {
                 return;
             }
 
-            std::vector<std::string> component;
+            if (!fastabi_cache)
+            {
+                build_fastabi_cache(c);
+                fastabi_cache = settings.fastabi_cache;
+            }
+            else
+            {
+                settings.fastabi_cache = *fastabi_cache;
+            }
+        }
 
-            while (true)
+        std::map<database const*, std::uint64_t> const& get_content_hashes(task_group& group)
+        {
+            if (!content_hashes)
             {
-                auto current = std::move(stack.back());
-                stack.pop_back();
-                on_stack[current] = false;
-                component.push_back(std::move(current));
+                content_hashes = get_database_content_hashes(c, group);
+            }
+
+            return *content_hashes;
+        }
+
+        static bool is_windows_runtime_type(TypeDef const& type)
+        {
+            return type.Flags().WindowsRuntime();
+        }
+
+        cache c;
+        std::vector<database_load> loads;
+        std::optional<symbol_table> table;
+        std::optional<std::uint64_t> filters_key;
+        type_filter projection_filter;
+        type_filter component_filter;
+        std::optional<std::map<TypeDef, TypeDef>> fastabi_cache;
+        std::optional<std::map<database const*, std::uint64_t>> content_hashes;
+        bool reused{};
+    };
 
-                if (component.back() == node)
+    // The metadata kept loaded by a server or batch, most recently used first, keeping at most capacity sets of files.
+    struct resident_metadata
+    {
+        explicit resident_metadata(std::size_t const capacity) noexcept :
+            m_capacity(capacity)
+        {
+        }
+
+        loaded_metadata& load(std::vector<std::string> const& files)
+        {
+            auto const key = get_files_fingerprint(files);
+
+            auto found = std::find_if(m_entries.begin(), m_entries.end(), [&](entry const& value)
+            {
+                return value.key == key;
+            });
+
+            if (found != m_entries.end())
+            {
+                m_entries.splice(m_entries.begin(), m_entries, found);
+                found->metadata.reused = true;
+            }
+            else
+            {
+                if (m_entries.size() == m_capacity)
                 {
-                    break;
+                    m_entries.pop_back();
                 }
+
+                m_entries.emplace_front(key, files);
             }
 
-            components.push_back(std::move(component));
-        };
+            return m_entries.front().metadata;
+        }
+
+    private:
 
-        for (auto&& node : nodes)
+        struct entry
         {
-            if (index.find(node) == index.end())
+            entry(std::uint64_t const files_key, std::vector<std::string> const& files) :
+                key(files_key),
+                metadata(files)
             {
-                strongconnect(node);
             }
+
+            std::uint64_t key;
+            loaded_metadata metadata;
+        };
+
+        std::size_t m_capacity;
+        std::list<entry> m_entries;
+    };
+
+    // Points a global at a local of run() until the guard goes away, so that the global never outlives the local when
+    // a run fails and the next request of a server or batch doesn't use it.
+    template <typename T>
+    struct global_guard
+    {
+        global_guard(global_guard const&) = delete;
+        global_guard& operator=(global_guard const&) = delete;
+
+        global_guard(T*& global, T* value) noexcept : m_global(global)
+        {
+            m_global = value;
         }
 
-        return components;
-    }
+        ~global_guard() noexcept
+        {
+            m_global = nullptr;
+        }
 
-    static int run(int const argc, char** argv)
+    private:
+
+        T*& m_global;
+    };
+
+    // Runs one invocation, writing its console output to w. A server or batch passes the metadata it keeps loaded, and
+    // the output is then returned to the caller rather than written to the console as it goes. A batch also passes the
+    // pool its jobs share, which is used unless the invocation asks for -synchronous.
+    static int run(int const argc, char** argv, writer& w, resident_metadata* resident, task_group* pool = nullptr)
     {
         int result{};
-        writer w;
 
         try
         {
@@ -573,12 +896,32 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
             }
 
             process_args(args);
-            cache c{ get_files_to_cache(), [](TypeDef const& type) { return type.Flags().WindowsRuntime(); } };
-            remove_foundation_types(c);
-            build_filters(c);
+            std::optional<trace_profile> profile;
+            global_guard profile_guard{ active_profile, args.exists("profile") ? &profile.emplace() : nullptr };
+            run_timings timings;
+            flush_statistics flushed;
+            global_guard statistics_guard{ output_statistics, args.exists("timings") ? &flushed : nullptr };
+
+            task_group local_group;
+            local_group.synchronous(args.exists("synchronous"));
+            local_group.jobs(get_jobs(args));
+            auto& group = pool && !args.exists("synchronous") ? *pool : local_group;
+            timings.phase("load");
+            std::optional<loaded_metadata> local;
+            auto& metadata = resident ? resident->load(get_files_to_cache()) : local.emplace(get_files_to_cache());
+            auto& c = metadata.c;
+            global_guard<symbol_table const> symbols_guard{ symbols, &*metadata.table };
+            type_memo<get_interfaces_t> interfaces;
+            type_memo<get_factories_t> factories;
+            global_guard interfaces_guard{ interfaces_memo, &interfaces };
+            global_guard factories_guard{ factories_memo, &factories };
+            timings.phase("filters");
+            metadata.apply_filters();
             settings.base = settings.base || settings.reference.empty();
             settings.base = settings.base || settings.modules;
-            build_fastabi_cache(c);
+            timings.phase("fastabi");
+            metadata.apply_fastabi_cache();
+            timings.stop();
 
             if (settings.verbose)
             {
@@ -613,12 +956,107 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
                 {
                     w.write(" cout:  %\n", settings.component_folder);
                 }
+
+                if (metadata.reused)
+                {
+                    w.write(" load:  reused from an earlier run\n");
+                }
+                else
+                {
+                    for (auto&& load : metadata.loads)
+                    {
+                        w.write(" load:  % (%us)\n", load.file, load.microseconds);
+                    }
+                }
+            }
+
+            if (!resident)
+            {
+                w.flush_to_console();
+            }
+
+            std::vector<TypeDef> classes;
+            std::vector<namespace_slot> slots;
+            manifest previous;
+            manifest current;
+            std::map<std::string_view, std::uint64_t> fingerprints;
+            std::size_t reused{};
+
+            for (auto&&[ns, members] : c.namespaces())
+            {
+                if (has_projected_types(members) && settings.projection_filter.includes(members))
+                {
+                    slots.push_back({ ns, &members });
+                }
+            }
+
+            // Tree shaking (see -usage) keeps every slot, so that the namespace headers and modules that other
+            // headers include still exist, but writes only the used types into them.
+            std::list<cache::namespace_members> used_members;
+
+            if (!settings.usage.empty())
+            {
+                timings.phase("usage");
+                settings.used_types = get_used_types(c, settings.usage);
+
+                for (auto& slot : slots)
+                {
+                    slot.members = &used_members.emplace_back(get_used_members(*slot.members, settings.used_types));
+                }
+            }
+
+            if (settings.incremental)
+            {
+                previous = read_manifest();
+                current.settings_fingerprint = get_settings_fingerprint(c);
+                fingerprints = get_namespace_fingerprints(c, metadata.get_content_hashes(group));
+
+                if (previous.settings_fingerprint != current.settings_fingerprint)
+                {
+                    previous.namespaces.clear();
+                }
+            }
+
+            remove_manifest();
+
+            std::optional<output_cache> outputs;
+            std::map<std::string_view, std::uint64_t> content_fingerprints;
+
+            if (args.exists("cache_dir"))
+            {
+                auto const& content_hashes = metadata.get_content_hashes(group);
+                content_fingerprints = get_namespace_fingerprints(c, content_hashes);
+                outputs.emplace(args.value("cache_dir"), get_cache_size(args), get_output_cache_settings_key(c, content_hashes));
+            }
+
+            std::optional<file_hash_cache> hashes;
+            global_guard hashes_guard{ output_hashes, args.exists("hash_cache") ? &hashes.emplace(settings.output_folder + "cppwinrt.hashes") : nullptr };
+
+            // The strongly connected components of the module graph and the owner of each namespace's module, which
+            // the module writers refer to, so they are declared ahead of the drain and outlive those callbacks.
+            std::vector<std::vector<std::uint32_t>> components;
+            std::vector<std::uint32_t> owner_of;
+
+            // If the run fails, wait for the callbacks already added to the pool before the locals they refer to go
+            // away, and discard their errors so that they are not reported by the next job sharing the pool.
+            struct group_drain
+            {
+                ~group_drain() noexcept
+                {
+                    try
+                    {
+                        group.get();
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+
+                task_group& group;
             }
+            drain{ group };
 
-            w.flush_to_console();
-            task_group group;
-            group.synchronous(args.exists("synchronous"));
-            std::map<std::string, std::vector<std::string>> module_imports;
+            timings.phase("writers");
 
             if (settings.modules)
             {
@@ -626,37 +1064,66 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
                 write_base_ixx();
             }
 
-            for (auto&&[ns, members] : c.namespaces())
+            for (auto& slot : slots)
             {
-                if (!has_projected_types(members) || !settings.projection_filter.includes(members))
+                if (settings.incremental && is_namespace_current(previous, fingerprints, slot.ns, *slot.members))
                 {
+                    slot.entry = previous.namespaces.find(slot.ns)->second;
+                    ++reused;
                     continue;
                 }
 
-                group.add([&, &ns = ns, &members = members]
+                ++timings.namespaces;
+
+                group.add([&, &slot = slot]
                 {
-                    if (settings.modules)
+                    auto timer = timings.time(timings.namespace_writers);
+                    auto const& ns = slot.ns;
+                    auto const& members = *slot.members;
+                    std::set<std::string> combined;
+                    auto restored = outputs ? outputs->restore(ns, members, content_fingerprints) : std::nullopt;
+
+                    if (restored)
                     {
-                        std::vector<std::string> imports;
-                        std::set<std::string> combined;
-                        write_namespace_0_h(c, ns, members, imports);
-                        combined.insert(imports.begin(), imports.end());
-                        write_namespace_1_h(c, ns, members, imports);
-                        combined.insert(imports.begin(), imports.end());
-                        write_namespace_2_h(c, ns, members, imports);
-                        combined.insert(imports.begin(), imports.end());
-                        write_namespace_h(c, ns, members, imports);
-                        combined.insert(imports.begin(), imports.end());
-
-                        module_imports.emplace(ns, std::vector<std::string>{ combined.begin(), combined.end() });
+                        slot.entry.imports = std::move(restored->imports);
+
+                        for (auto&& [depends_namespace, hash] : restored->depends)
+                        {
+                            combined.insert(depends_namespace);
+                        }
                     }
                     else
                     {
-                        std::vector<std::string> unused;
-                        write_namespace_0_h(c, ns, members, unused);
-                        write_namespace_1_h(c, ns, members, unused);
-                        write_namespace_2_h(c, ns, members, unused);
-                        write_namespace_h(c, ns, members, unused);
+                        std::vector<std::string> depends;
+                        write_namespace_0_h(ns, members, depends);
+                        combined.insert(depends.begin(), depends.end());
+                        write_namespace_1_h(ns, members, depends);
+                        combined.insert(depends.begin(), depends.end());
+                        write_namespace_2_h(ns, members, depends);
+                        combined.insert(depends.begin(), depends.end());
+                        write_namespace_h(c, ns, members, depends);
+                        combined.insert(depends.begin(), depends.end());
+
+                        if (settings.modules)
+                        {
+                            slot.entry.imports = get_module_imports(c, combined);
+                        }
+
+                        if (outputs)
+                        {
+                            outputs->store(ns, members, content_fingerprints, combined, slot.entry.imports);
+                        }
+                    }
+
+                    if (settings.incremental)
+                    {
+                        slot.entry.fingerprint = fingerprints.at(ns);
+
+                        for (auto&& depends_namespace : combined)
+                        {
+                            auto found = fingerprints.find(depends_namespace);
+                            slot.entry.depends.emplace_back(depends_namespace, found == fingerprints.end() ? 0 : found->second);
+                        }
                     }
                 });
             }
@@ -672,8 +1139,6 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
 
             if (settings.component)
             {
-                std::vector<TypeDef> classes;
-
                 for (auto&&[ns, members] : c.namespaces())
                 {
                     for (auto&& type : members.classes)
@@ -687,79 +1152,159 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
 
                 if (!classes.empty())
                 {
-                    write_fast_forward_h(classes);
-                    write_module_g_cpp(classes);
+                    timings.components += classes.size();
+
+                    group.add([&]
+                    {
+                        auto timer = timings.time(timings.component_writers);
+                        write_fast_forward_h(classes);
+                        write_module_g_cpp(classes);
+                    });
 
                     for (auto&& type : classes)
                     {
-                        write_component_g_h(type);
-                        write_component_g_cpp(type);
-                        write_component_h(type);
-                        write_component_cpp(type);
+                        group.add([&type, &timings]
+                        {
+                            auto timer = timings.time(timings.component_writers);
+                            write_component_g_h(type);
+                            write_component_g_cpp(type);
+                            write_component_h(type);
+                            write_component_cpp(type);
+                        });
                     }
                 }
             }
 
             group.get();
 
+            if (settings.incremental)
+            {
+                for (auto&& slot : slots)
+                {
+                    current.namespaces.emplace(slot.ns, slot.entry);
+                }
+            }
+
             if (settings.modules)
             {
-                auto components = compute_strongly_connected_components(module_imports);
-                std::map<std::string, std::vector<std::string>> members_by_owner;
-                std::map<std::string, std::string> owner_of;
+                timings.phase("scc");
+                std::vector<std::vector<std::uint32_t>> graph(slots.size());
 
-                for (auto& component : components)
+                for (std::uint32_t node{}; node != slots.size(); ++node)
                 {
-                    std::sort(component.begin(), component.end());
-                    auto const& owner = component.front();
-                    members_by_owner.emplace(owner, component);
-
-                    for (auto const& ns : component)
+                    for (auto&& module_import : slots[node].entry.imports)
                     {
-                        owner_of.emplace(ns, owner);
+                        auto const dep = find_namespace_slot(slots, module_import);
+
+                        if (dep != slots.size())
+                        {
+                            graph[node].push_back(dep);
+                        }
                     }
                 }
 
-                for (auto const& [owner, members] : members_by_owner)
+                components = compute_strongly_connected_components(graph);
+                owner_of.resize(slots.size());
+
+                for (auto&& component : components)
                 {
-                    if (members.size() == 1)
+                    for (auto node : component)
                     {
-                        write_namespace_ixx(owner, module_imports.at(owner));
-                        continue;
+                        owner_of[node] = component.front();
                     }
+                }
 
-                    std::set<std::string> external_imports;
+                timings.phase("modules");
 
-                    for (auto const& ns : members)
+                for (auto&& component : components)
+                {
+                    group.add([&]
                     {
-                        for (auto const& dep : module_imports.at(ns))
+                        auto const owner = component.front();
+
+                        if (component.size() == 1)
+                        {
+                            write_namespace_ixx(slots[owner].ns, slots[owner].entry.imports);
+                            return;
+                        }
+
+                        std::vector<std::string> members;
+                        std::set<std::string> external_imports;
+
+                        for (auto node : component)
                         {
-                            auto found = owner_of.find(dep);
+                            members.emplace_back(slots[node].ns);
 
-                            if (found != owner_of.end() && found->second == owner)
+                            for (auto&& module_import : slots[node].entry.imports)
                             {
-                                continue;
-                            }
+                                auto const dep = find_namespace_slot(slots, module_import);
 
-                            external_imports.emplace(dep);
+                                if (dep == slots.size() || owner_of[dep] != owner)
+                                {
+                                    external_imports.emplace(module_import);
+                                }
+                            }
                         }
-                    }
 
-                    std::vector<std::string> imports{ external_imports.begin(), external_imports.end() };
-                    write_namespace_scc_owner_ixx(c, owner, members, imports);
+                        std::vector<std::string> imports{ external_imports.begin(), external_imports.end() };
+                        write_namespace_scc_owner_ixx(c, slots[owner].ns, members, imports);
 
-                    for (auto const& ns : members)
-                    {
-                        if (ns != owner)
+                        for (auto node : component)
                         {
-                            write_namespace_reexport_ixx(ns, owner);
+                            if (node != owner)
+                            {
+                                write_namespace_reexport_ixx(slots[node].ns, slots[owner].ns);
+                            }
                         }
-                    }
+                    });
                 }
+
+                group.get();
+            }
+
+            timings.phase("manifest");
+
+            if (settings.incremental)
+            {
+                write_manifest(current);
+            }
+
+            if (hashes)
+            {
+                output_hashes = nullptr;
+                hashes->save();
+            }
+
+            if (outputs)
+            {
+                outputs->trim();
+            }
+
+            if (args.exists("timings"))
+            {
+                output_statistics = nullptr;
+                timings.write(args.value("timings"), flushed);
+            }
+
+            if (profile)
+            {
+                timings.stop();
+                active_profile = nullptr;
+                profile->save(args.value("profile"));
             }
 
             if (settings.verbose)
             {
+                if (settings.incremental)
+                {
+                    w.write(" reuse: % namespaces\n", reused);
+                }
+
+                if (outputs)
+                {
+                    w.write(" cache: % hits, % misses, % stored, % evicted\n", outputs->hits.load(), outputs->misses.load(), outputs->stored.load(), outputs->evicted);
+                }
+
                 w.write(" time:  %ms\n", get_elapsed_time(start));
             }
         }
@@ -773,6 +1318,155 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
             result = 1;
         }
 
+        return result;
+    }
+
+    // Runs the invocations forwarded by clients, one at a time, keeping the metadata they load for later requests.
+    [[noreturn]] static void serve(std::string const& path)
+    {
+        if (path.empty())
+        {
+            throw_invalid("Option 'serve' requires a path");
+        }
+
+        resident_metadata resident{ 4 };
+
+        serve_requests(path, [&](server_request const& request)
+        {
+            server_reply reply;
+            writer w;
+
+            try
+            {
+                settings = {};
+                std::filesystem::current_path(request.directory);
+                std::vector<char*> argv;
+
+                for (auto&& argument : request.arguments)
+                {
+                    argv.push_back(const_cast<char*>(argument.c_str()));
+                }
+
+                argv.push_back(nullptr);
+                reply.result = run(static_cast<int>(request.arguments.size()), argv.data(), w, &resident);
+            }
+            catch (std::exception const& e)
+            {
+                w.write("cppwinrt : error %\n", e.what());
+                reply.result = 1;
+            }
+
+            reply.output = w.flush_to_string();
+            return reply;
+        });
+
+        throw_invalid("The cppwinrt server stopped unexpectedly");
+    }
+
+    // Runs each line of a batch file as an invocation of its own, in order, on one pool of threads. Jobs that read the
+    // same metadata files share one copy of it, which stays loaded until the batch ends. Blank lines and lines starting
+    // with # are skipped, and each job's console output is written once it completes.
+    static int run_batch(char* program, std::string const& filename, task_group& pool)
+    {
+        std::ifstream file(filename);
+
+        if (!file)
+        {
+            throw_invalid("Cannot read batch file '", filename, "'");
+        }
+
+        resident_metadata resident{ (std::numeric_limits<std::size_t>::max)() };
+        int result{};
+        std::string line;
+
+        while (std::getline(file, line))
+        {
+            auto arguments = reader::split_command_line(line);
+
+            if (arguments.empty() || arguments.front().starts_with('#'))
+            {
+                continue;
+            }
+
+            std::vector<char*> argv{ program };
+
+            for (auto&& argument : arguments)
+            {
+                argv.push_back(argument.data());
+            }
+
+            argv.push_back(nullptr);
+            settings = {};
+            writer w;
+            auto const job_result = run(static_cast<int>(argv.size() - 1), argv.data(), w, &resident, &pool);
+            w.flush_to_console(job_result == 0);
+
+            if (job_result != 0)
+            {
+                result = job_result;
+            }
+        }
+
+        return result;
+    }
+
+    static int run(int const argc, char** argv)
+    {
+        writer w;
+        std::optional<reader> args;
+
+        try
+        {
+            args.emplace(argc, argv, options);
+        }
+        catch (std::exception const&)
+        {
+            // Invalid arguments are reported by the run below.
+        }
+
+        if (args && args->exists("serve"))
+        {
+            try
+            {
+                serve(args->value("serve"));
+            }
+            catch (std::exception const& e)
+            {
+                w.write("cppwinrt : error %\n", e.what());
+                w.flush_to_console(false);
+                return 1;
+            }
+        }
+
+        if (args && args->exists("batch"))
+        {
+            try
+            {
+                task_group pool;
+                pool.synchronous(args->exists("synchronous"));
+                pool.jobs(get_jobs(*args));
+                return run_batch(argv[0], args->value("batch"), pool);
+            }
+            catch (std::exception const& e)
+            {
+                w.write("cppwinrt : error %\n", e.what());
+                w.flush_to_console(false);
+                return 1;
+            }
+        }
+
+        if (args && args->exists("connect"))
+        {
+            server_request request{ std::filesystem::current_path().string(), { argv, argv + argc } };
+
+            if (auto reply = forward_to_server(args->value("connect"), request))
+            {
+                std::fwrite(reply->output.data(), 1, reply->output.size(), reply->result == 0 ? stdout : stderr);
+                return reply->result;
+            }
+        }
+
+        auto const result = run(argc, argv, w, nullptr);
         w.flush_to_console(result == 0);
         return result;
     }
@@ -0,0 +1,257 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // What the previous run recorded for a namespace: the fingerprint of its metadata, the fingerprints of the
+    // namespaces its headers referenced, and its module imports (when generating modules).
+    struct manifest_entry
+    {
+        std::uint64_t fingerprint{};
+        std::vector<std::pair<std::string, std::uint64_t>> depends;
+        std::vector<std::string> imports;
+    };
+
+    struct manifest
+    {
+        std::uint64_t settings_fingerprint{};
+        std::map<std::string, manifest_entry, std::less<>> namespaces;
+    };
+
+    static constexpr std::string_view manifest_header{ "cppwinrt-manifest 1" };
+
+    static std::string get_manifest_filename()
+    {
+        return settings.output_folder + "cppwinrt.manifest";
+    }
+
+    // Fingerprints everything other than the metadata that can change the generated projection: the tool version,
+    // the options, and the set of projected namespaces (which drives parent namespace includes).
+    static std::uint64_t get_settings_fingerprint(cache const& c)
+    {
+        fingerprint result;
+        result.add(CPPWINRT_VERSION_STRING);
+
+        for (auto flag : { settings.base, settings.modules, settings.license, settings.brackets, settings.component,
+            settings.component_prefix, settings.component_opt, settings.component_ignore_velocity, settings.fastabi, settings.split_types })
+        {
+            result.add(flag);
+        }
+
+        result.add(settings.license_template);
+        result.add(settings.component_name);
+        result.add(settings.component_lib);
+
+        for (auto const* files : { &settings.input, &settings.reference, &settings.include, &settings.exclude })
+        {
+            result.add(files->size());
+
+            for (auto&& file : *files)
+            {
+                result.add(file);
+            }
+        }
+
+        result.add(settings.used_types.size());
+
+        for (auto&& type : settings.used_types)
+        {
+            result.add(type.TypeNamespace());
+            result.add(type.TypeName());
+        }
+
+        for (auto&& [ns, members] : c.namespaces())
+        {
+            if (has_projected_types(members))
+            {
+                result.add(ns);
+            }
+        }
+
+        return result.value;
+    }
+
+    // Fingerprints each database by its content, reading the files on the pool. The result doesn't depend on where
+    // the files are or when they were written, so touching a .winmd, or checking it out or restoring it again, doesn't
+    // make the namespaces it defines look changed, and the fingerprints can be compared across checkouts.
+    static std::map<database const*, std::uint64_t> get_database_content_hashes(cache const& c, task_group& group)
+    {
+        std::vector<std::pair<database const*, std::uint64_t>> hashes;
+
+        for (auto&& db : c.databases())
+        {
+            hashes.emplace_back(&db, 0);
+        }
+
+        for (auto& [db, hash] : hashes)
+        {
+            group.add([db = db, &hash = hash]
+            {
+                std::ifstream file(db->path(), std::ios::in | std::ios::binary);
+
+                if (!file)
+                {
+                    throw_invalid("Cannot read '", db->path(), "'");
+                }
+
+                fingerprint content;
+                std::vector<char> buffer(1024 * 1024);
+
+                while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || file.gcount() != 0)
+                {
+                    content.add_bytes({ buffer.data(), static_cast<std::size_t>(file.gcount()) });
+                }
+
+                hash = content.value;
+            });
+        }
+
+        group.get();
+        return std::map<database const*, std::uint64_t>(hashes.begin(), hashes.end());
+    }
+
+    // Fingerprints each namespace by the fingerprints of the databases that define its types, so that a namespace is
+    // only considered changed when one of those .winmd files changes.
+    static std::map<std::string_view, std::uint64_t> get_namespace_fingerprints(cache const& c, std::map<database const*, std::uint64_t> const& databases)
+    {
+        std::map<std::string_view, std::uint64_t> result;
+
+        for (auto&& [ns, members] : c.namespaces())
+        {
+            std::set<std::uint64_t> sources;
+
+            for (auto&& [name, type] : members.types)
+            {
+                sources.insert(databases.at(&type.get_database()));
+            }
+
+            fingerprint value;
+            value.add(ns);
+
+            for (auto source : sources)
+            {
+                value.add(source);
+            }
+
+            result.emplace(ns, value.value);
+        }
+
+        return result;
+    }
+
+    static manifest read_manifest()
+    {
+        manifest result;
+        std::ifstream file(get_manifest_filename());
+        std::string line;
+
+        if (!getline(file, line) || line != manifest_header)
+        {
+            return result;
+        }
+
+        auto parse_hash = [](std::string_view const& value)
+        {
+            std::uint64_t hash{};
+            std::from_chars(value.data(), value.data() + value.size(), hash, 16);
+            return hash;
+        };
+
+        manifest_entry* current{};
+
+        while (getline(file, line))
+        {
+            std::string_view value{ line };
+            auto space = value.find(' ');
+            auto key = value.substr(0, space);
+            value = space == std::string_view::npos ? std::string_view{} : value.substr(space + 1);
+            space = value.find(' ');
+            auto name = value.substr(0, space);
+            auto hash = space == std::string_view::npos ? std::string_view{} : value.substr(space + 1);
+
+            if (key == "settings")
+            {
+                result.settings_fingerprint = parse_hash(name);
+            }
+            else if (key == "namespace")
+            {
+                current = &result.namespaces[std::string{ name }];
+                current->fingerprint = parse_hash(hash);
+            }
+            else if (current && key == "depends")
+            {
+                current->depends.emplace_back(name, parse_hash(hash));
+            }
+            else if (current && key == "import")
+            {
+                current->imports.emplace_back(name);
+            }
+        }
+
+        return result;
+    }
+
+    static void write_manifest(manifest const& value)
+    {
+        auto format_hash = [](std::uint64_t const hash)
+        {
+            char buffer[16];
+            auto const end = std::to_chars(std::begin(buffer), std::end(buffer), hash, 16).ptr;
+            return std::string{ buffer, end };
+        };
+
+        writer w;
+        w.write("%\n", manifest_header);
+        w.write("settings %\n", format_hash(value.settings_fingerprint));
+
+        for (auto&& [ns, entry] : value.namespaces)
+        {
+            w.write("namespace % %\n", ns, format_hash(entry.fingerprint));
+
+            for (auto&& [depends, hash] : entry.depends)
+            {
+                w.write("depends % %\n", depends, format_hash(hash));
+            }
+
+            for (auto&& module_import : entry.imports)
+            {
+                w.write("import %\n", module_import);
+            }
+        }
+
+        w.flush_to_file(get_manifest_filename());
+    }
+
+    // Removes the manifest of the previous run before any header is written, so that it never describes headers
+    // that a later run, or one that failed part way, has since changed. Incremental runs write a new one when done.
+    static void remove_manifest()
+    {
+        std::error_code ec;
+        std::filesystem::remove(get_manifest_filename(), ec);
+    }
+
+    static bool is_namespace_current(manifest const& previous, std::map<std::string_view, std::uint64_t> const& fingerprints,
+        std::string_view const& ns, cache::namespace_members const& members)
+    {
+        auto entry = previous.namespaces.find(ns);
+
+        if (entry == previous.namespaces.end() || entry->second.fingerprint != fingerprints.at(ns))
+        {
+            return false;
+        }
+
+        for (auto&& [depends, hash] : entry->second.depends)
+        {
+            auto found = fingerprints.find(depends);
+
+            if (found == fingerprints.end() || found->second != hash)
+            {
+                return false;
+            }
+        }
+
+        auto const headers = get_namespace_headers(ns, members);
+
+        return std::all_of(headers.begin(), headers.end(), [](std::string const& header) { return exists(settings.output_folder + header); }) &&
+            (!settings.modules || exists(settings.output_folder + "winrt/" + std::string{ ns } + ".ixx"));
+    }
+}
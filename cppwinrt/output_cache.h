@@ -0,0 +1,362 @@
+#pragma once
+
+namespace cppwinrt
+{
+    static constexpr std::string_view output_cache_header{ "cppwinrt-cache 1" };
+
+    // Like get_settings_fingerprint, but naming the input metadata by its content rather than its path, so that runs
+    // over the same metadata and options from different folders agree.
+    static std::uint64_t get_output_cache_settings_key(cache const& c, std::map<database const*, std::uint64_t> const& content_hashes)
+    {
+        fingerprint result;
+        result.add(output_cache_header);
+        result.add(CPPWINRT_VERSION_STRING);
+
+        for (auto flag : { settings.base, settings.modules, settings.license, settings.brackets, settings.component,
+            settings.component_prefix, settings.component_opt, settings.component_ignore_velocity, settings.fastabi, settings.split_types })
+        {
+            result.add(flag);
+        }
+
+        result.add(settings.license_template);
+        result.add(settings.component_name);
+        result.add(settings.component_lib);
+
+        for (auto const* prefixes : { &settings.include, &settings.exclude })
+        {
+            result.add(prefixes->size());
+
+            for (auto&& prefix : *prefixes)
+            {
+                result.add(prefix);
+            }
+        }
+
+        std::set<std::uint64_t> inputs;
+
+        for (auto&& db : c.databases())
+        {
+            if (settings.input.count(db.path()))
+            {
+                inputs.insert(content_hashes.at(&db));
+            }
+        }
+
+        result.add(inputs.size());
+
+        for (auto input : inputs)
+        {
+            result.add(input);
+        }
+
+        result.add(settings.used_types.size());
+
+        for (auto&& type : settings.used_types)
+        {
+            result.add(type.TypeNamespace());
+            result.add(type.TypeName());
+        }
+
+        for (auto&& [ns, members] : c.namespaces())
+        {
+            if (has_projected_types(members))
+            {
+                result.add(ns);
+            }
+        }
+
+        return result.value;
+    }
+
+    // A store of generated namespace headers shared by runs and output folders (see -cache_dir). Each entry is a folder
+    // named by a hash of the options, the namespace and the content of the metadata defining it, holding the
+    // namespace's headers and a list of the namespaces they referenced along with the content hashes of those. An entry
+    // is only restored while those hashes still match. Headers are copied between the store and the output folders,
+    // never linked, so that nothing done to an output can change the store. Entries are added by renaming a complete
+    // folder into place, so concurrent runs can share the store, and the least recently used entries are removed once
+    // the store grows past its size limit.
+    struct output_cache
+    {
+        output_cache(std::filesystem::path const& folder, std::uint64_t const max_bytes, std::uint64_t const settings_key) :
+            m_folder(folder),
+            m_max_bytes(max_bytes),
+            m_settings_key(settings_key)
+        {
+            std::filesystem::create_directories(m_folder);
+        }
+
+        // Restores the headers of ns into the output folder, returning what the run that stored them recorded about
+        // its module imports and referenced namespaces, or nothing if there is no current entry.
+        std::optional<manifest_entry> restore(std::string_view const& ns, cache::namespace_members const& members,
+            std::map<std::string_view, std::uint64_t> const& fingerprints)
+        {
+            auto const folder = m_folder / get_entry_name(ns, fingerprints.at(ns));
+            auto entry = read_entry(folder / "entry");
+
+            if (entry && is_entry_current(*entry, fingerprints))
+            {
+                auto const headers = get_namespace_headers(ns, members);
+
+                if (settings.split_types)
+                {
+                    std::error_code error;
+                    std::filesystem::create_directories(settings.output_folder + "winrt/" + std::string{ ns }, error);
+                }
+
+                if (std::all_of(headers.begin(), headers.end(), [&](std::string const& header)
+                    {
+                        return restore_file(folder / std::filesystem::path{ header }.filename(), settings.output_folder + header);
+                    }))
+                {
+                    if (settings.split_types)
+                    {
+                        remove_stale_split_type_headers(ns, members);
+                    }
+
+                    std::error_code error;
+                    std::filesystem::last_write_time(folder / "entry", std::filesystem::file_time_type::clock::now(), error);
+                    ++hits;
+                    return entry;
+                }
+            }
+
+            ++misses;
+            return {};
+        }
+
+        // Adds the headers just written for ns to the store. Failures are ignored, as the store is only an optimization.
+        void store(std::string_view const& ns, cache::namespace_members const& members, std::map<std::string_view, std::uint64_t> const& fingerprints,
+            std::set<std::string> const& depends, std::vector<std::string> const& imports) noexcept
+        {
+            try
+            {
+                auto const name = get_entry_name(ns, fingerprints.at(ns));
+                auto const temporary = m_folder / (name + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) +
+                    "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+                std::filesystem::create_directory(temporary);
+
+                {
+                    std::ofstream file(temporary / "entry", std::ios::out | std::ios::binary);
+                    file << output_cache_header << '\n';
+
+                    for (auto&& depends_namespace : depends)
+                    {
+                        auto found = fingerprints.find(depends_namespace);
+                        file << "depends " << depends_namespace << ' ' << (found == fingerprints.end() ? 0 : found->second) << '\n';
+                    }
+
+                    for (auto&& module_import : imports)
+                    {
+                        file << "import " << module_import << '\n';
+                    }
+                }
+
+                for (auto&& header : get_namespace_headers(ns, members))
+                {
+                    if (!store_file(settings.output_folder + header, temporary / std::filesystem::path{ header }.filename()))
+                    {
+                        std::filesystem::remove_all(temporary);
+                        return;
+                    }
+                }
+
+                std::error_code error;
+                std::filesystem::remove_all(m_folder / name, error);
+                std::filesystem::rename(temporary, m_folder / name, error);
+
+                if (error)
+                {
+                    std::filesystem::remove_all(temporary, error);
+                    return;
+                }
+
+                ++stored;
+            }
+            catch (...)
+            {
+            }
+        }
+
+        // Removes the least recently used entries until the store fits within its size limit, along with any
+        // partly written entries left behind more than an hour ago.
+        void trim()
+        {
+            auto const now = std::filesystem::file_time_type::clock::now();
+            std::vector<std::tuple<std::filesystem::file_time_type, std::uint64_t, std::filesystem::path>> entries;
+            std::uint64_t total{};
+            std::error_code error;
+
+            for (auto&& item : std::filesystem::directory_iterator(m_folder, error))
+            {
+                auto const path = item.path();
+                auto const time = std::filesystem::last_write_time(path / "entry", error);
+
+                if (path.filename().string().find('.') != std::string::npos || error)
+                {
+                    if (std::filesystem::last_write_time(path, error) < now - std::chrono::hours(1) && !error)
+                    {
+                        std::filesystem::remove_all(path, error);
+                    }
+
+                    continue;
+                }
+
+                std::uint64_t size{};
+
+                for (auto&& file : std::filesystem::directory_iterator(path, error))
+                {
+                    size += file.file_size(error);
+                }
+
+                entries.emplace_back(time, size, path);
+                total += size;
+            }
+
+            std::sort(entries.begin(), entries.end());
+
+            for (auto&& [time, size, path] : entries)
+            {
+                if (total <= m_max_bytes)
+                {
+                    break;
+                }
+
+                if (std::filesystem::remove_all(path, error) != static_cast<std::uintmax_t>(-1))
+                {
+                    total -= size;
+                    ++evicted;
+                }
+            }
+        }
+
+        std::atomic<std::uint32_t> hits{};
+        std::atomic<std::uint32_t> misses{};
+        std::atomic<std::uint32_t> stored{};
+        std::uint32_t evicted{};
+
+    private:
+
+        std::string get_entry_name(std::string_view const& ns, std::uint64_t const namespace_fingerprint) const
+        {
+            fingerprint key;
+            key.add(m_settings_key);
+            key.add(ns);
+            key.add(namespace_fingerprint);
+
+            char buffer[16];
+            auto const end = std::to_chars(std::begin(buffer), std::end(buffer), key.value, 16).ptr;
+            return { buffer, end };
+        }
+
+        static std::optional<manifest_entry> read_entry(std::filesystem::path const& filename)
+        {
+            std::ifstream file(filename);
+            std::string line;
+
+            if (!getline(file, line) || line != output_cache_header)
+            {
+                return {};
+            }
+
+            manifest_entry result;
+
+            while (getline(file, line))
+            {
+                std::string_view value{ line };
+                auto space = value.find(' ');
+                auto key = value.substr(0, space);
+                value = space == std::string_view::npos ? std::string_view{} : value.substr(space + 1);
+
+                if (key == "depends")
+                {
+                    space = value.find(' ');
+                    auto hash = space == std::string_view::npos ? std::string_view{} : value.substr(space + 1);
+                    std::uint64_t number{};
+                    std::from_chars(hash.data(), hash.data() + hash.size(), number);
+                    result.depends.emplace_back(value.substr(0, space), number);
+                }
+                else if (key == "import")
+                {
+                    result.imports.emplace_back(value);
+                }
+            }
+
+            return result;
+        }
+
+        static bool is_entry_current(manifest_entry const& entry, std::map<std::string_view, std::uint64_t> const& fingerprints)
+        {
+            return std::all_of(entry.depends.begin(), entry.depends.end(), [&](auto&& depends)
+            {
+                auto found = fingerprints.find(depends.first);
+                return (found == fingerprints.end() ? 0 : found->second) == depends.second;
+            });
+        }
+
+        static bool files_equal(std::filesystem::path const& left, std::filesystem::path const& right)
+        {
+            std::error_code error;
+            auto const size = std::filesystem::file_size(left, error);
+
+            if (error || size != std::filesystem::file_size(right, error) || error)
+            {
+                return false;
+            }
+
+            std::ifstream left_file(left, std::ios::binary);
+            std::ifstream right_file(right, std::ios::binary);
+            char left_buffer[16 * 1024];
+            char right_buffer[16 * 1024];
+
+            do
+            {
+                left_file.read(left_buffer, sizeof(left_buffer));
+                right_file.read(right_buffer, sizeof(right_buffer));
+
+                if (left_file.gcount() != right_file.gcount() || 0 != std::memcmp(left_buffer, right_buffer, static_cast<std::size_t>(left_file.gcount())))
+                {
+                    return false;
+                }
+            }
+            while (left_file.gcount() != 0);
+
+            return true;
+        }
+
+        // Restores a header from the store. A header that already holds the same content is left alone, so that its
+        // last write time still reflects when it last changed. Otherwise it is copied rather than linked and given the
+        // current time, so that it is never older than the objects built against the header it replaces, and never
+        // shares its file with the store.
+        static bool restore_file(std::filesystem::path const& from, std::filesystem::path const& to)
+        {
+            if (files_equal(from, to))
+            {
+                return true;
+            }
+
+            std::error_code error;
+            std::filesystem::remove(to, error);
+
+            if (!std::filesystem::copy_file(from, to, std::filesystem::copy_options::overwrite_existing, error) || error)
+            {
+                return false;
+            }
+
+            std::filesystem::last_write_time(to, std::filesystem::file_time_type::clock::now(), error);
+            return !error;
+        }
+
+        // Adds a header to the store. It is copied rather than linked, so that a build step that later edits the
+        // output in place cannot change what the store restores.
+        static bool store_file(std::filesystem::path const& from, std::filesystem::path const& to)
+        {
+            std::error_code error;
+            return std::filesystem::copy_file(from, to, std::filesystem::copy_options::overwrite_existing, error) && !error;
+        }
+
+        std::filesystem::path const m_folder;
+        std::uint64_t const m_max_bytes;
+        std::uint64_t const m_settings_key;
+    };
+}
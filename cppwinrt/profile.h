@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cppwinrt
+{
+    // Bytes passed to writer_base::flush_to_file by the current thread, so that a span can report the output
+    // produced while it was open.
+    inline thread_local std::uint64_t trace_bytes_flushed{};
+
+    // Collects complete ("X") events in the Chrome trace event format for the -profile option. The resulting file
+    // can be opened with chrome://tracing or https://ui.perfetto.dev.
+    struct trace_profile
+    {
+        using clock = std::chrono::steady_clock;
+
+        void add(std::string_view const& category, std::string_view const& name, std::string_view const& target,
+            clock::time_point const& start, clock::time_point const& end, std::uint64_t const bytes)
+        {
+            auto const id = std::this_thread::get_id();
+            std::lock_guard lock(m_lock);
+            auto const thread = m_threads.emplace(id, static_cast<std::uint32_t>(m_threads.size())).first->second;
+
+            m_events.push_back({ std::string{ category }, std::string{ name }, std::string{ target },
+                microseconds(start), microseconds(end) - microseconds(start), bytes, thread });
+        }
+
+        void save(std::string const& filename) const
+        {
+            std::ofstream file(filename, std::ios::out | std::ios::binary);
+            file << "{\"traceEvents\":[";
+            bool first{ true };
+
+            std::lock_guard lock(m_lock);
+
+            for (auto&& event : m_events)
+            {
+                file << (first ? "\n" : ",\n");
+                first = false;
+                file << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread;
+                file << ",\"cat\":\"" << escape(event.category) << "\",\"name\":\"" << escape(event.name) << '"';
+                file << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+                file << ",\"args\":{\"bytes\":" << event.bytes;
+
+                if (!event.target.empty())
+                {
+                    file << ",\"target\":\"" << escape(event.target) << '"';
+                }
+
+                file << "}}";
+            }
+
+            file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+            if (!file)
+            {
+                throw std::filesystem::filesystem_error("Failed to write profile", filename, std::io_errc::stream);
+            }
+        }
+
+    private:
+
+        struct trace_event
+        {
+            std::string category;
+            std::string name;
+            std::string target;
+            std::int64_t start{};
+            std::int64_t duration{};
+            std::uint64_t bytes{};
+            std::uint32_t thread{};
+        };
+
+        std::int64_t microseconds(clock::time_point const& time) const noexcept
+        {
+            return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(time - m_start).count());
+        }
+
+        static std::string escape(std::string_view const& value)
+        {
+            std::string result;
+            result.reserve(value.size());
+
+            for (auto c : value)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    result += '\\';
+                }
+
+                result += c;
+            }
+
+            return result;
+        }
+
+        clock::time_point const m_start{ clock::now() };
+        mutable std::mutex m_lock;
+        std::map<std::thread::id, std::uint32_t> m_threads;
+        std::vector<trace_event> m_events;
+    };
+
+    // When set, trace_span adds its events to this profile.
+    inline trace_profile* active_profile{};
+
+    // Records the time between its construction and destruction as an event, along with the bytes flushed to files
+    // by the current thread in the meantime. Does nothing unless -profile is in effect.
+    struct trace_span
+    {
+        trace_span(trace_span const&) = delete;
+        trace_span& operator=(trace_span const&) = delete;
+
+        trace_span(std::string_view const& category, std::string_view const& name, std::string_view const& target = {}) noexcept :
+            m_profile(active_profile),
+            m_category(category),
+            m_name(name),
+            m_target(target)
+        {
+            if (m_profile)
+            {
+                m_bytes = trace_bytes_flushed;
+                m_start = trace_profile::clock::now();
+            }
+        }
+
+        ~trace_span() noexcept
+        {
+            if (m_profile)
+            {
+                try
+                {
+                    m_profile->add(m_category, m_name, m_target, m_start, trace_profile::clock::now(), trace_bytes_flushed - m_bytes);
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+
+    private:
+
+        trace_profile* m_profile{};
+        std::string_view m_category;
+        std::string_view m_name;
+        std::string_view m_target;
+        trace_profile::clock::time_point m_start;
+        std::uint64_t m_bytes{};
+    };
+}
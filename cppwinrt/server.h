@@ -0,0 +1,353 @@
+#pragma once
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace cppwinrt
+{
+    // An invocation forwarded to a server (see -serve and -connect): the client's working directory and arguments.
+    struct server_request
+    {
+        std::string directory;
+        std::vector<std::string> arguments;
+    };
+
+    // The server's answer: the exit code and the console output of the run.
+    struct server_reply
+    {
+        int result{};
+        std::string output;
+    };
+
+    // One end of a connection between a client and the server, over a Unix domain socket or, on Windows, a named
+    // pipe. Messages are sent as a 32-bit length followed by that many bytes.
+    struct server_connection
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        using handle_type = HANDLE;
+        static inline handle_type const invalid_handle = INVALID_HANDLE_VALUE;
+#else
+        using handle_type = int;
+        static constexpr handle_type invalid_handle = -1;
+#endif
+
+        server_connection(server_connection const&) = delete;
+        server_connection& operator=(server_connection const&) = delete;
+
+        explicit server_connection(handle_type handle, bool server = false) noexcept :
+            m_handle(handle),
+            m_server(server)
+        {
+        }
+
+        ~server_connection() noexcept
+        {
+            if (m_handle == invalid_handle)
+            {
+                return;
+            }
+
+#if defined(_WIN32) || defined(_WIN64)
+            if (m_server)
+            {
+                FlushFileBuffers(m_handle);
+                DisconnectNamedPipe(m_handle);
+            }
+
+            CloseHandle(m_handle);
+#else
+            ::close(m_handle);
+#endif
+        }
+
+        handle_type native_handle() const noexcept
+        {
+            return m_handle;
+        }
+
+        void send(std::string_view const& value)
+        {
+            auto const size = static_cast<std::uint32_t>(value.size());
+            send_bytes(&size, sizeof(size));
+            send_bytes(value.data(), value.size());
+        }
+
+        std::string receive()
+        {
+            std::uint32_t size{};
+            receive_bytes(&size, sizeof(size));
+            std::string result(size, '\0');
+            receive_bytes(result.data(), size);
+            return result;
+        }
+
+        void send(server_request const& request)
+        {
+            send(request.directory);
+            send(std::to_string(request.arguments.size()));
+
+            for (auto&& argument : request.arguments)
+            {
+                send(argument);
+            }
+        }
+
+        void receive(server_request& request)
+        {
+            request.directory = receive();
+            auto const count = std::stoul(receive());
+            request.arguments.clear();
+
+            for (unsigned long index{}; index != count; ++index)
+            {
+                request.arguments.push_back(receive());
+            }
+        }
+
+        void send(server_reply const& reply)
+        {
+            send(std::to_string(reply.result));
+            send(reply.output);
+        }
+
+        void receive(server_reply& reply)
+        {
+            reply.result = std::stoi(receive());
+            reply.output = receive();
+        }
+
+    private:
+
+        void send_bytes(void const* data, std::size_t size)
+        {
+            auto next = static_cast<char const*>(data);
+
+            while (size != 0)
+            {
+#if defined(_WIN32) || defined(_WIN64)
+                DWORD written{};
+
+                if (!WriteFile(m_handle, next, static_cast<DWORD>((std::min)(size, std::size_t{ 64 * 1024 })), &written, nullptr))
+                {
+                    throw_invalid("Failed to write to the cppwinrt server connection");
+                }
+#else
+                auto const written = ::write(m_handle, next, size);
+
+                if (written == -1 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (written <= 0)
+                {
+                    throw_invalid("Failed to write to the cppwinrt server connection");
+                }
+#endif
+                next += written;
+                size -= static_cast<std::size_t>(written);
+            }
+        }
+
+        void receive_bytes(void* data, std::size_t size)
+        {
+            auto next = static_cast<char*>(data);
+
+            while (size != 0)
+            {
+#if defined(_WIN32) || defined(_WIN64)
+                DWORD read{};
+
+                if (!ReadFile(m_handle, next, static_cast<DWORD>((std::min)(size, std::size_t{ 64 * 1024 })), &read, nullptr) || read == 0)
+                {
+                    throw_invalid("Failed to read from the cppwinrt server connection");
+                }
+#else
+                auto const read = ::read(m_handle, next, size);
+
+                if (read == -1 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (read <= 0)
+                {
+                    throw_invalid("Failed to read from the cppwinrt server connection");
+                }
+#endif
+                next += read;
+                size -= static_cast<std::size_t>(read);
+            }
+        }
+
+        handle_type m_handle;
+        bool m_server{};
+    };
+
+#if defined(_WIN32) || defined(_WIN64)
+    // Names given to -serve and -connect are placed in the named pipe namespace unless they already are.
+    inline std::string get_server_pipe_name(std::string const& name)
+    {
+        static constexpr std::string_view prefix{ R"(\\.\pipe\)" };
+        return starts_with(name, prefix) ? name : std::string{ prefix } + name;
+    }
+#else
+    inline sockaddr_un get_server_address(std::string const& path)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            throw_invalid("Server socket path '", path, "' is too long");
+        }
+
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+#endif
+
+    // Connects to the server at path, returning nothing if no server is listening there.
+    inline std::optional<server_connection> connect_to_server(std::string const& path)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        auto const name = get_server_pipe_name(path);
+
+        while (true)
+        {
+            HANDLE pipe = CreateFileA(name.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+
+            if (pipe != INVALID_HANDLE_VALUE)
+            {
+                return std::optional<server_connection>{ std::in_place, pipe };
+            }
+
+            // The server handles one request at a time, so wait for it to become free.
+            if (GetLastError() != ERROR_PIPE_BUSY || !WaitNamedPipeA(name.c_str(), NMPWAIT_WAIT_FOREVER))
+            {
+                return {};
+            }
+        }
+#else
+        auto const address = get_server_address(path);
+        int const socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        if (socket == -1)
+        {
+            return {};
+        }
+
+        if (::connect(socket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) == -1)
+        {
+            ::close(socket);
+            return {};
+        }
+
+        return std::optional<server_connection>{ std::in_place, socket };
+#endif
+    }
+
+    // Sends a request to the server at path and waits for its reply. Returns nothing if no server is listening there,
+    // or if the connection fails before the reply arrives, in which case the caller runs the request itself.
+    inline std::optional<server_reply> forward_to_server(std::string const& path, server_request const& request)
+    {
+        try
+        {
+            auto connection = connect_to_server(path);
+
+            if (!connection)
+            {
+                return {};
+            }
+
+            connection->send(request);
+            server_reply reply;
+            connection->receive(reply);
+            return reply;
+        }
+        catch (std::exception const&)
+        {
+            return {};
+        }
+    }
+
+    // Listens at path and calls handler for each request, one at a time, until the process is stopped. A request
+    // that fails to arrive or whose reply cannot be sent only ends that connection.
+    template <typename F>
+    void serve_requests(std::string const& path, F&& handler)
+    {
+        if (connect_to_server(path))
+        {
+            throw_invalid("A cppwinrt server is already listening at '", path, "'");
+        }
+
+        auto handle = [&](server_connection& connection)
+        {
+            try
+            {
+                server_request request;
+                connection.receive(request);
+                connection.send(handler(request));
+            }
+            catch (std::exception const&)
+            {
+            }
+        };
+
+#if defined(_WIN32) || defined(_WIN64)
+        auto const name = get_server_pipe_name(path);
+
+        while (true)
+        {
+            HANDLE pipe = CreateNamedPipeA(name.c_str(), PIPE_ACCESS_DUPLEX, PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                PIPE_UNLIMITED_INSTANCES, 64 * 1024, 64 * 1024, 0, nullptr);
+
+            if (pipe == INVALID_HANDLE_VALUE)
+            {
+                throw_invalid("Failed to create the cppwinrt server pipe '", name, "'");
+            }
+
+            server_connection connection{ pipe, true };
+
+            if (ConnectNamedPipe(pipe, nullptr) || GetLastError() == ERROR_PIPE_CONNECTED)
+            {
+                handle(connection);
+            }
+        }
+#else
+        // A client that goes away before its reply is sent must not stop the server.
+        std::signal(SIGPIPE, SIG_IGN);
+
+        auto const address = get_server_address(path);
+        ::unlink(path.c_str());
+        server_connection listener{ ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0) };
+
+        if (::bind(listener.native_handle(), reinterpret_cast<sockaddr const*>(&address), sizeof(address)) == -1 ||
+            ::listen(listener.native_handle(), SOMAXCONN) == -1)
+        {
+            throw_invalid("Failed to listen at '", path, "': ", std::strerror(errno));
+        }
+
+        while (true)
+        {
+            int const socket = ::accept(listener.native_handle(), nullptr, nullptr);
+
+            if (socket == -1)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                {
+                    continue;
+                }
+
+                throw_invalid("Failed to accept a connection at '", path, "': ", std::strerror(errno));
+            }
+
+            server_connection connection{ socket };
+            handle(connection);
+        }
+#endif
+    }
+}
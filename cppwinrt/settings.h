@@ -10,6 +10,7 @@ namespace cppwinrt
         std::string output_folder;
         bool base{};
         bool modules{};
+        bool incremental{};
         bool license{};
         std::string license_template;
         bool brackets{};
@@ -27,10 +28,14 @@ namespace cppwinrt
         std::set<std::string> include;
         std::set<std::string> exclude;
 
-        winmd::reader::filter projection_filter;
-        winmd::reader::filter component_filter;
+        type_filter projection_filter;
+        type_filter component_filter;
+
+        std::vector<std::string> usage;
+        std::set<winmd::reader::TypeDef> used_types;
 
         bool fastabi{};
+        bool split_types{};
         std::map<winmd::reader::TypeDef, winmd::reader::TypeDef> fastabi_cache;
     };
 
@@ -0,0 +1,103 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // Gives every namespace and type in the cache a dense integer id, so that the writers can collect and order the
+    // types they depend on by comparing integers rather than names. Ids are assigned in name order, so ordering by
+    // id matches ordering by name, and the types of a namespace have contiguous ids. The table is read-only once
+    // built and may be shared by the writer threads.
+    struct symbol_table
+    {
+        explicit symbol_table(cache const& c)
+        {
+            struct row
+            {
+                std::string_view ns;
+                std::string_view name;
+                TypeDef type;
+            };
+
+            std::vector<row> rows;
+
+            for (auto&& db : c.databases())
+            {
+                m_databases[&db].resize(db.TypeDef.size());
+
+                for (auto&& type : db.TypeDef)
+                {
+                    rows.push_back({ type.TypeNamespace(), type.TypeName(), type });
+                }
+            }
+
+            // Sorting the rows themselves, rather than just their names, gives each row its id as the sorted rows
+            // are walked, so a reference database costs no more than a pass over its TypeDef table.
+            std::stable_sort(rows.begin(), rows.end(), [](row const& left, row const& right)
+            {
+                return std::tie(left.ns, left.name) < std::tie(right.ns, right.name);
+            });
+
+            for (auto first = rows.begin(); first != rows.end();)
+            {
+                auto last = std::find_if(first + 1, rows.end(), [&](row const& value)
+                {
+                    return value.ns != first->ns || value.name != first->name;
+                });
+
+                auto const id = static_cast<std::uint32_t>(m_types.size());
+
+                if (m_namespaces.empty() || m_namespaces.back() != first->ns)
+                {
+                    m_namespaces.push_back(first->ns);
+                }
+
+                m_type_namespaces.push_back(static_cast<std::uint32_t>(m_namespaces.size() - 1));
+
+                // Prefer the definition the cache resolves the name to when more than one database defines it.
+                // Otherwise, and for types removed from the cache, use the first definition.
+                TypeDef resolved;
+
+                if (last - first > 1)
+                {
+                    resolved = c.find(first->ns, first->name);
+                }
+
+                m_types.push_back(resolved ? resolved : first->type);
+
+                for (; first != last; ++first)
+                {
+                    m_databases[&first->type.get_database()][first->type.index()] = id;
+                }
+            }
+        }
+
+        [[nodiscard]] std::uint32_t type_id(TypeDef const& type) const
+        {
+            return m_databases.at(&type.get_database())[type.index()];
+        }
+
+        [[nodiscard]] TypeDef const& type(std::uint32_t const id) const noexcept
+        {
+            return m_types[id];
+        }
+
+        [[nodiscard]] std::uint32_t namespace_id(std::uint32_t const type_id) const noexcept
+        {
+            return m_type_namespaces[type_id];
+        }
+
+        [[nodiscard]] std::string_view namespace_name(std::uint32_t const id) const noexcept
+        {
+            return m_namespaces[id];
+        }
+
+    private:
+
+        std::vector<std::string_view> m_namespaces;
+        std::vector<TypeDef> m_types;
+        std::vector<std::uint32_t> m_type_namespaces;
+        std::unordered_map<database const*, std::vector<std::uint32_t>> m_databases;
+    };
+
+    // Set by main.cpp once the cache is loaded, before any writers run, and cleared when the run ends.
+    inline symbol_table const* symbols{};
+}
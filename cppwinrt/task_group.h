@@ -1,7 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace cppwinrt
 {
+    // Runs callbacks on a bounded pool of worker threads. Each worker owns a queue that it drains from the back,
+    // and steals from the front of the other queues when its own queue is empty. The thread calling get() joins in
+    // the same way until every callback added so far has completed.
     struct task_group
     {
         task_group(task_group const&) = delete;
@@ -11,9 +25,18 @@ namespace cppwinrt
 
         ~task_group() noexcept
         {
-            for (auto&& task : m_tasks)
+            wait();
+
+            {
+                std::lock_guard lock(m_lock);
+                m_stopping = true;
+            }
+
+            m_changed.notify_all();
+
+            for (auto&& thread : m_threads)
             {
-                task.wait();
+                thread.join();
             }
         }
 
@@ -22,37 +45,203 @@ namespace cppwinrt
             m_synchronous = synchronous;
         }
 
+        // Sets the number of worker threads, where zero (the default) uses the number of hardware threads.
+        // Has no effect once the first callback has been added.
+        void jobs(std::uint32_t jobs) noexcept
+        {
+            m_jobs = jobs;
+        }
+
         template <typename T>
         void add(T&& callback)
         {
             if (m_synchronous)
             {
                 callback();
+                return;
             }
-            else
+
+            start();
+            auto& queue = m_queues[m_next++ % m_queues.size()];
+
+            // The counters are raised before the task is queued, since a worker may pop and finish it immediately.
             {
-                m_tasks.push_back(std::async(std::forward<T>(callback)));
+                std::lock_guard lock(m_lock);
+                ++m_pending;
+                ++m_queued;
             }
+
+            try
+            {
+                std::lock_guard lock(queue.lock);
+                queue.tasks.emplace_back(std::forward<T>(callback));
+            }
+            catch (...)
+            {
+                std::lock_guard lock(m_lock);
+                --m_pending;
+                --m_queued;
+                throw;
+            }
+
+            m_changed.notify_one();
         }
 
         void get()
         {
-            auto tasks = std::move(m_tasks);
+            wait();
 
-            for (auto&& task : tasks)
+            if (auto exception = std::exchange(m_exception, nullptr))
             {
-                task.wait();
+                std::rethrow_exception(exception);
             }
+        }
 
-            for (auto&& task : tasks)
+    private:
+
+        struct task_queue
+        {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void start()
+        {
+            if (!m_threads.empty())
             {
-                task.get();
+                return;
+            }
+
+            std::uint32_t const count = m_jobs ? m_jobs : (std::max)(1u, std::thread::hardware_concurrency());
+            m_queues = std::vector<task_queue>(count);
+            m_threads.reserve(count);
+
+            for (std::uint32_t index{}; index != count; ++index)
+            {
+                m_threads.emplace_back([this, index] { work(index); });
             }
         }
 
-    private:
+        bool try_pop(std::size_t const index, std::function<void()>& task)
+        {
+            auto const count = m_queues.size();
+
+            if (index < count)
+            {
+                auto& queue = m_queues[index];
+                std::lock_guard lock(queue.lock);
+
+                if (!queue.tasks.empty())
+                {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+            }
+
+            for (std::size_t offset = 1; !task && offset <= count; ++offset)
+            {
+                auto& queue = m_queues[(index + offset) % count];
+                std::lock_guard lock(queue.lock);
+
+                if (!queue.tasks.empty())
+                {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+            }
+
+            if (!task)
+            {
+                return false;
+            }
+
+            std::lock_guard lock(m_lock);
+            --m_queued;
+            return true;
+        }
+
+        void run(std::function<void()>& task) noexcept
+        {
+            std::exception_ptr exception;
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            task = nullptr;
+            std::lock_guard lock(m_lock);
+
+            if (exception && !m_exception)
+            {
+                m_exception = exception;
+            }
+
+            if (--m_pending == 0)
+            {
+                m_changed.notify_all();
+            }
+        }
+
+        void work(std::size_t const index) noexcept
+        {
+            while (true)
+            {
+                std::function<void()> task;
+
+                if (try_pop(index, task))
+                {
+                    run(task);
+                    continue;
+                }
+
+                std::unique_lock lock(m_lock);
+                m_changed.wait(lock, [&] { return m_stopping || m_queued != 0; });
+
+                if (m_stopping && m_queued == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        void wait() noexcept
+        {
+            while (true)
+            {
+                std::function<void()> task;
+
+                if (try_pop(m_queues.size(), task))
+                {
+                    run(task);
+                    continue;
+                }
+
+                std::unique_lock lock(m_lock);
+
+                if (m_pending == 0)
+                {
+                    return;
+                }
+
+                m_changed.wait(lock, [&] { return m_pending == 0 || m_queued != 0; });
+            }
+        }
 
-        std::vector<std::future<void>> m_tasks;
+        std::vector<task_queue> m_queues;
+        std::vector<std::thread> m_threads;
+        std::atomic<std::size_t> m_next{};
+        std::mutex m_lock;
+        std::condition_variable m_changed;
+        std::size_t m_pending{};
+        std::size_t m_queued{};
+        std::exception_ptr m_exception;
+        std::uint32_t m_jobs{};
         bool m_synchronous{};
+        bool m_stopping{};
     };
 }
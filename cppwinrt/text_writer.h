@@ -1,13 +1,36 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "profile.h"
+
 namespace cppwinrt
 {
     inline std::string file_to_string(std::string const& filename)
@@ -16,30 +39,407 @@ namespace cppwinrt
         return static_cast<std::stringstream const&>(std::stringstream() << file.rdbuf()).str();
     }
 
+    // 64-bit FNV-1a hash used to fingerprint generated content, metadata and settings.
+    struct fingerprint
+    {
+        std::uint64_t value{ 0xcbf29ce484222325 };
+
+        void add(std::uint64_t const number) noexcept
+        {
+            for (std::uint32_t shift{}; shift != 64; shift += 8)
+            {
+                value ^= (number >> shift) & 0xff;
+                value *= 0x100000001b3;
+            }
+        }
+
+        void add(std::string_view const& text) noexcept
+        {
+            add(text.size());
+            add_bytes(text);
+        }
+
+        void add_bytes(std::string_view const& bytes) noexcept
+        {
+            for (auto c : bytes)
+            {
+                value ^= static_cast<std::uint8_t>(c);
+                value *= 0x100000001b3;
+            }
+        }
+    };
+
+    // Sidecar cache of the size, last write time and content hash of files written by writer_base::flush_to_file.
+    // When an existing file still has the recorded size and last write time, its recorded hash stands in for its
+    // content, so unchanged outputs are detected without reading them back.
+    struct file_hash_cache
+    {
+        struct entry
+        {
+            std::uint64_t hash{};
+            std::uint64_t size{};
+            std::int64_t time{};
+        };
+
+        explicit file_hash_cache(std::string filename) : m_filename(std::move(filename))
+        {
+            std::ifstream file(m_filename, std::ios::binary);
+            entry value;
+            std::string name;
+
+            while (file >> std::hex >> value.hash >> std::dec >> value.size >> value.time && file.get() == ' ' && getline(file, name))
+            {
+                m_entries.insert_or_assign(name, value);
+            }
+        }
+
+        bool is_current(std::string const& filename, std::uint64_t const size, std::uint64_t const hash) const
+        {
+            entry value;
+
+            {
+                std::lock_guard lock(m_lock);
+                auto found = m_entries.find(filename);
+
+                if (found == m_entries.end())
+                {
+                    return false;
+                }
+
+                value = found->second;
+            }
+
+            if (value.hash != hash || value.size != size)
+            {
+                return false;
+            }
+
+            std::error_code error;
+            auto const current_size = std::filesystem::file_size(filename, error);
+
+            if (error || current_size != size)
+            {
+                return false;
+            }
+
+            auto const current_time = std::filesystem::last_write_time(filename, error);
+            return !error && current_time.time_since_epoch().count() == value.time;
+        }
+
+        void update(std::string const& filename, std::uint64_t const hash)
+        {
+            std::error_code error;
+            entry value{ hash, std::filesystem::file_size(filename, error) };
+
+            if (!error)
+            {
+                value.time = static_cast<std::int64_t>(std::filesystem::last_write_time(filename, error).time_since_epoch().count());
+            }
+
+            std::lock_guard lock(m_lock);
+
+            if (error)
+            {
+                m_entries.erase(filename);
+            }
+            else
+            {
+                m_entries.insert_or_assign(filename, value);
+            }
+        }
+
+        void save() const
+        {
+            std::ofstream file(m_filename, std::ios::binary);
+
+            for (auto&& [name, value] : m_entries)
+            {
+                file << std::hex << value.hash << std::dec << ' ' << value.size << ' ' << value.time << ' ' << name << '\n';
+            }
+        }
+
+    private:
+
+        std::string m_filename;
+        mutable std::mutex m_lock;
+        std::map<std::string, entry> m_entries;
+    };
+
+    // When set, writer_base::flush_to_file consults and updates this cache.
+    inline file_hash_cache* output_hashes{};
+
+    // Totals for the calls to writer_base::flush_to_file.
+    struct flush_statistics
+    {
+        std::atomic<std::uint64_t> files{};
+        std::atomic<std::uint64_t> written{};
+        std::atomic<std::uint64_t> bytes{};
+        std::atomic<std::uint64_t> microseconds{};
+    };
+
+    // When set, writer_base::flush_to_file adds to these totals.
+    inline flush_statistics* output_statistics{};
+
+    // Recycles the fixed-size chunks used by the text_buffer objects of a single writer.
+    struct text_arena
+    {
+        static constexpr std::size_t chunk_size{ 64 * 1024 };
+
+        std::unique_ptr<char[]> acquire()
+        {
+            if (m_free.empty())
+            {
+                return std::unique_ptr<char[]>(new char[chunk_size]);
+            }
+
+            auto chunk = std::move(m_free.back());
+            m_free.pop_back();
+            return chunk;
+        }
+
+        void release(std::unique_ptr<char[]>&& chunk)
+        {
+            m_free.push_back(std::move(chunk));
+        }
+
+    private:
+
+        std::vector<std::unique_ptr<char[]>> m_free;
+    };
+
+    // Segmented text buffer made of fixed-size chunks, so that appending never moves text already written.
+    struct text_buffer
+    {
+        static constexpr std::size_t chunk_size{ text_arena::chunk_size };
+
+        explicit text_buffer(text_arena& arena) noexcept : m_arena(arena)
+        {
+        }
+
+        text_buffer(text_buffer const&) = delete;
+        text_buffer& operator=(text_buffer const&) = delete;
+
+        void append(std::string_view value)
+        {
+            while (!value.empty())
+            {
+                if (m_chunks.empty() || m_used == chunk_size)
+                {
+                    m_chunks.push_back(m_arena.acquire());
+                    m_used = 0;
+                }
+
+                auto const count = (std::min)(value.size(), chunk_size - m_used);
+                std::memcpy(m_chunks.back().get() + m_used, value.data(), count);
+                m_used += count;
+                value.remove_prefix(count);
+            }
+        }
+
+        void push_back(char const value)
+        {
+            if (m_chunks.empty() || m_used == chunk_size)
+            {
+                m_chunks.push_back(m_arena.acquire());
+                m_used = 0;
+            }
+
+            m_chunks.back()[m_used++] = value;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_chunks.empty() ? 0 : (m_chunks.size() - 1) * chunk_size + m_used;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_chunks.empty();
+        }
+
+        char back() const noexcept
+        {
+            return m_chunks.empty() ? char{} : m_chunks.back()[m_used - 1];
+        }
+
+        // Copies the text from offset to the end of the buffer.
+        std::string substr(std::size_t const offset) const
+        {
+            std::string result;
+            result.reserve(size() - offset);
+            auto index = offset / chunk_size;
+            auto first = offset % chunk_size;
+
+            for (; index < m_chunks.size(); ++index, first = 0)
+            {
+                auto const last = index + 1 == m_chunks.size() ? m_used : chunk_size;
+                result.append(m_chunks[index].get() + first, last - first);
+            }
+
+            return result;
+        }
+
+        // Shrinks the buffer to size, returning the chunks no longer needed to the arena.
+        void truncate(std::size_t const size)
+        {
+            auto const keep = (size + chunk_size - 1) / chunk_size;
+
+            while (m_chunks.size() > keep)
+            {
+                m_arena.release(std::move(m_chunks.back()));
+                m_chunks.pop_back();
+            }
+
+            m_used = keep == 0 ? 0 : size - (keep - 1) * chunk_size;
+        }
+
+        void clear()
+        {
+            truncate(0);
+        }
+
+        void swap(text_buffer& other) noexcept
+        {
+            m_chunks.swap(other.m_chunks);
+            std::swap(m_used, other.m_used);
+        }
+
+        // Calls the callback with each chunk in order.
+        template <typename F>
+        void for_each(F const& callback) const
+        {
+            for (std::size_t index{}; index != m_chunks.size(); ++index)
+            {
+                callback(std::string_view{ m_chunks[index].get(), index + 1 == m_chunks.size() ? m_used : chunk_size });
+            }
+        }
+
+    private:
+
+        text_arena& m_arena;
+        std::vector<std::unique_ptr<char[]>> m_chunks;
+        std::size_t m_used{};
+    };
+
+    // Wraps a format string that is only known at run time, such as one chosen by a condition or one of the
+    // strings:: templates, so that it can be passed to writer_base::write. It is then checked when it is used.
+    struct runtime_format
+    {
+        std::string_view value;
+    };
+
+    // The format string taken by writer_base::write. '%' is replaced by the next argument, '@' by the next argument
+    // written as code, and '^' escapes the character that follows it. The placeholders are found and counted against
+    // the arguments at compile time, so a mismatch fails to compile rather than producing broken output.
+    template <std::size_t Count>
+    struct format_string
+    {
+        template <typename S> requires std::is_convertible_v<S, std::string_view>
+        consteval format_string(S const format) : value(format)
+        {
+            parse();
+        }
+
+        format_string(runtime_format const& format) : value(format.value)
+        {
+            parse();
+        }
+
+        std::string_view value;
+        std::array<std::uint32_t, Count> placeholders{};
+        bool escapes{};
+
+    private:
+
+        constexpr void parse()
+        {
+            std::size_t count{};
+
+            for (std::size_t offset{}; offset != value.size(); ++offset)
+            {
+                if (value[offset] == '^')
+                {
+                    if (++offset == value.size())
+                    {
+                        invalid_format("Format string ends with an escape");
+                    }
+
+                    escapes = true;
+                }
+                else if (value[offset] == '%' || value[offset] == '@')
+                {
+                    if (count == Count)
+                    {
+                        invalid_format("Format string has more placeholders than arguments");
+                    }
+
+                    placeholders[count++] = static_cast<std::uint32_t>(offset);
+                }
+            }
+
+            if (count != Count)
+            {
+                invalid_format("Format string has fewer placeholders than arguments");
+            }
+        }
+
+        // Not constexpr, so that reaching it while parsing at compile time is a compile error.
+        [[noreturn]] static void invalid_format(char const* message)
+        {
+            throw std::invalid_argument(message);
+        }
+    };
+
     template <typename T>
     struct writer_base
     {
         writer_base(writer_base const&) = delete;
         writer_base& operator=(writer_base const&) = delete;
 
-        writer_base()
-        {
-            m_first.reserve(16 * 1024);
-        }
+        writer_base() = default;
 
         template <typename... Args>
-        void write(std::string_view const& value, Args const&... args)
+        void write(format_string<sizeof...(Args)> const& format, Args const&... args)
         {
-#if defined(_DEBUG)
-            auto expected = count_placeholders(value);
-            auto actual = sizeof...(Args);
-            assert(expected == actual);
-#endif
-            write_segment(value, args...);
+            if constexpr (sizeof...(Args) == 0)
+            {
+                write_literal(format.value, format.escapes);
+            }
+            else
+            {
+                std::size_t offset{};
+                std::size_t index{};
+
+                auto write_argument = [&](auto const& argument)
+                {
+                    auto const placeholder = format.placeholders[index++];
+                    write_literal(format.value.substr(offset, placeholder - offset), format.escapes);
+                    offset = placeholder + 1;
+
+                    if (format.value[placeholder] == '%')
+                    {
+                        static_cast<T*>(this)->write(argument);
+                    }
+                    else
+                    {
+                        if constexpr (std::is_convertible_v<decltype(argument), std::string_view>)
+                        {
+                            static_cast<T*>(this)->write_code(argument);
+                        }
+                        else
+                        {
+                            assert(false); // '@' placeholders are only for text.
+                        }
+                    }
+                };
+
+                (write_argument(args), ...);
+                write_literal(format.value.substr(offset), format.escapes);
+            }
         }
 
         template <typename... Args>
-        std::string write_temp(std::string_view const& value, Args const&... args)
+        std::string write_temp(format_string<sizeof...(Args)> const& format, Args const&... args)
         {
 #if defined(_DEBUG)
             bool restore_debug_trace = debug_trace;
@@ -47,11 +447,10 @@ namespace cppwinrt
 #endif
             auto const size = m_first.size();
 
-            assert(count_placeholders(value) == sizeof...(Args));
-            write_segment(value, args...);
+            write(format, args...);
 
-            std::string result{ m_first.data() + size, m_first.size() - size };
-            m_first.resize(size);
+            std::string result = m_first.substr(size);
+            m_first.truncate(size);
 
 #if defined(_DEBUG)
             debug_trace = restore_debug_trace;
@@ -61,7 +460,7 @@ namespace cppwinrt
 
         void write_impl(std::string_view const& value)
         {
-            m_first.insert(m_first.end(), value.begin(), value.end());
+            m_first.append(value);
 
 #if defined(_DEBUG)
             if (debug_trace)
@@ -106,32 +505,32 @@ namespace cppwinrt
 
         void write(int const value)
         {
-            write(std::to_string(value));
+            write_integer(value);
         }
 
         void write(unsigned int const value)
         {
-            write(std::to_string(value));
+            write_integer(value);
         }
 
         void write(signed long const value)
         {
-            write(std::to_string(value));
+            write_integer(value);
         }
 
         void write(unsigned long const value)
         {
-            write(std::to_string(value));
+            write_integer(value);
         }
 
         void write(signed long long const value)
         {
-            write(std::to_string(value));
+            write_integer(value);
         }
 
         void write(unsigned long long const value)
         {
-            write(std::to_string(value));
+            write_integer(value);
         }
 
         template <typename... Args>
@@ -162,36 +561,72 @@ namespace cppwinrt
 
         void swap() noexcept
         {
-            std::swap(m_second, m_first);
+            m_second.swap(m_first);
         }
 
         void flush_to_console(bool to_stdout = true) noexcept
         {
-            std::fprintf(to_stdout ? stdout : stderr, "%.*s", static_cast<int>(m_first.size()), m_first.data());
-            std::fprintf(to_stdout ? stdout : stderr, "%.*s", static_cast<int>(m_second.size()), m_second.data());
+            auto const stream = to_stdout ? stdout : stderr;
+            auto const write_chunk = [stream](std::string_view const& chunk) noexcept
+            {
+                std::fwrite(chunk.data(), 1, chunk.size(), stream);
+            };
+
+            m_first.for_each(write_chunk);
+            m_second.for_each(write_chunk);
             m_first.clear();
             m_second.clear();
         }
 
         void flush_to_file(std::string const& filename)
         {
-            if (!file_equal(filename))
+            trace_span span{ "io", "flush_to_file", filename };
+            auto const statistics = output_statistics;
+            auto const start = statistics ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+            auto const hashes = output_hashes;
+            auto const size = m_first.size() + m_second.size();
+            bool written{};
+            std::uint64_t hash{};
+
+            if (hashes)
             {
-                std::ofstream file;
-                file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-                try
+                fingerprint content;
+                auto const add_chunk = [&](std::string_view const& chunk) { content.add_bytes(chunk); };
+                m_first.for_each(add_chunk);
+                m_second.for_each(add_chunk);
+                hash = content.value;
+            }
+
+            if (!hashes || !hashes->is_current(filename, size, hash))
+            {
+                if (!file_equal(filename))
                 {
-                  file.open(filename, std::ios::out | std::ios::binary);
-                  file.write(m_first.data(), m_first.size());
-                  file.write(m_second.data(), m_second.size());
+                    write_file(filename);
+                    written = true;
                 }
-                catch (std::ofstream::failure const& e)
+
+                if (hashes)
                 {
-                  throw std::filesystem::filesystem_error(e.what(), filename, std::io_errc::stream);
+                    hashes->update(filename, hash);
                 }
             }
+
             m_first.clear();
             m_second.clear();
+            trace_bytes_flushed += size;
+
+            if (statistics)
+            {
+                ++statistics->files;
+
+                if (written)
+                {
+                    ++statistics->written;
+                }
+
+                statistics->bytes += size;
+                statistics->microseconds += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+            }
         }
 
         void flush_to_file(std::filesystem::path const& filename)
@@ -203,8 +638,9 @@ namespace cppwinrt
         {
             std::string result;
             result.reserve(m_first.size() + m_second.size());
-            result.assign(m_first.begin(), m_first.end());
-            result.append(m_second.begin(), m_second.end());
+            auto const append_chunk = [&](std::string_view const& chunk) { result.append(chunk); };
+            m_first.for_each(append_chunk);
+            m_second.for_each(append_chunk);
             m_first.clear();
             m_second.clear();
             return result;
@@ -212,29 +648,38 @@ namespace cppwinrt
 
         char back()
         {
-            return m_first.empty() ? char{} : m_first.back();
+            return m_first.back();
         }
 
         bool file_equal(std::string const& filename) const
         {
-            if (!std::filesystem::exists(filename))
+            std::error_code error;
+            auto const size = std::filesystem::file_size(filename, error);
+
+            if (error || size != m_first.size() + m_second.size())
             {
                 return false;
             }
 
-            auto file = file_to_string(filename);
+            std::ifstream file(filename, std::ios::binary);
+            char buffer[16 * 1024];
 
-            if (file.size() != m_first.size() + m_second.size())
-            {
-                return false;
-            }
+            bool equal{ true };
 
-            if (!std::equal(m_first.begin(), m_first.end(), file.begin(), file.begin() + m_first.size()))
+            // Compares the file against the buffers a piece at a time, stopping at the first difference.
+            auto compare = [&](std::string_view expected)
             {
-                return false;
-            }
+                while (equal && !expected.empty())
+                {
+                    auto const count = (std::min)(sizeof(buffer), expected.size());
+                    equal = file.read(buffer, static_cast<std::streamsize>(count)) && 0 == std::memcmp(buffer, expected.data(), count);
+                    expected.remove_prefix(count);
+                }
+            };
 
-            return std::equal(m_second.begin(), m_second.end(), file.begin() + m_first.size(), file.end());
+            m_first.for_each(compare);
+            m_second.for_each(compare);
+            return equal;
         }
 
 #if defined(_DEBUG)
@@ -243,87 +688,115 @@ namespace cppwinrt
 
     private:
 
-        static constexpr std::uint32_t count_placeholders(std::string_view const& format) noexcept
+        [[noreturn]] static void throw_write_error(std::string const& filename, std::error_code const& error)
+        {
+            throw std::filesystem::filesystem_error("Failed to write file", filename, error);
+        }
+
+        // Replaces the file rather than truncating it, so that a file hard linked from the -cache_dir store is never
+        // modified in place.
+        void write_file(std::string const& filename)
         {
-            std::uint32_t count{};
-            bool escape{};
+            std::error_code removed;
+            std::filesystem::remove(filename, removed);
+
+#if defined(_WIN32) || defined(_WIN64)
+            std::ofstream file;
+            file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            try
+            {
+              file.open(filename, std::ios::out | std::ios::binary);
+              auto const write_chunk = [&](std::string_view const& chunk) { file.write(chunk.data(), static_cast<std::streamsize>(chunk.size())); };
+              m_first.for_each(write_chunk);
+              m_second.for_each(write_chunk);
+            }
+            catch (std::ofstream::failure const& e)
+            {
+              throw std::filesystem::filesystem_error(e.what(), filename, std::io_errc::stream);
+            }
+#else
+            std::vector<iovec> buffers;
+            auto const add_chunk = [&](std::string_view const& chunk) { buffers.push_back({ const_cast<char*>(chunk.data()), chunk.size() }); };
+            m_first.for_each(add_chunk);
+            m_second.for_each(add_chunk);
+
+            int const file = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+            if (file == -1)
+            {
+                throw_write_error(filename, { errno, std::generic_category() });
+            }
+
+#if defined(IOV_MAX)
+            std::size_t const batch{ IOV_MAX };
+#else
+            std::size_t const batch{ 16 };
+#endif
+            auto next = buffers.data();
+            auto remaining = buffers.size();
 
-            for (auto c : format)
+            while (remaining != 0)
             {
-                if (!escape)
+                auto written = ::writev(file, next, static_cast<int>((std::min)(remaining, batch)));
+
+                if (written == -1)
                 {
-                    if (c == '^')
+                    if (errno == EINTR)
                     {
-                        escape = true;
                         continue;
                     }
 
-                    if (c == '%' || c == '@')
-                    {
-                        ++count;
-                    }
+                    std::error_code const error{ errno, std::generic_category() };
+                    ::close(file);
+                    throw_write_error(filename, error);
                 }
-                escape = false;
-            }
 
-            return count;
-        }
+                // Skips the buffers written completely and advances into a partially written one.
+                for (; remaining != 0 && static_cast<std::size_t>(written) >= next->iov_len; ++next, --remaining)
+                {
+                    written -= static_cast<ssize_t>(next->iov_len);
+                }
 
-        void write_segment(std::string_view const& value)
-        {
-            auto offset = value.find_first_of("^");
-            if (offset == std::string_view::npos)
-            {
-                write(value);
-                return;
+                if (remaining != 0)
+                {
+                    next->iov_base = static_cast<char*>(next->iov_base) + written;
+                    next->iov_len -= static_cast<std::size_t>(written);
+                }
             }
 
-            write(value.substr(0, offset));
-
-            assert(offset != value.size() - 1);
-
-            write(value[offset + 1]);
-            write_segment(value.substr(offset + 2));
+            if (::close(file) == -1)
+            {
+                throw_write_error(filename, { errno, std::generic_category() });
+            }
+#endif
         }
 
-        template <typename First, typename... Rest>
-        void write_segment(std::string_view const& value, First const& first, Rest const&... rest)
+        template <typename Integer>
+        void write_integer(Integer const value)
         {
-            auto offset = value.find_first_of("^%@");
-            assert(offset != std::string_view::npos);
-            write(value.substr(0, offset));
-
-            if (value[offset] == '^')
-            {
-                assert(offset != value.size() - 1);
+            char buffer[24];
+            auto const result = std::to_chars(buffer, std::end(buffer), value);
+            write(std::string_view{ buffer, static_cast<std::size_t>(result.ptr - buffer) });
+        }
 
-                write(value[offset + 1]);
-                write_segment(value.substr(offset + 2), first, rest...);
-            }
-            else
+        void write_literal(std::string_view value, bool const escapes)
+        {
+            if (escapes)
             {
-                if (value[offset] == '%')
+                for (auto offset = value.find('^'); offset != std::string_view::npos; offset = value.find('^'))
                 {
-                    static_cast<T*>(this)->write(first);
+                    write(value.substr(0, offset));
+                    write(value[offset + 1]);
+                    value.remove_prefix(offset + 2);
                 }
-                else
-                {
-                    if constexpr (std::is_convertible_v<First, std::string_view>)
-                    {
-                        static_cast<T*>(this)->write_code(first);
-                    }
-                    else
-                    {
-                        assert(false); // '@' placeholders are only for text.
-                    }
-                }
-
-                write_segment(value.substr(offset + 1), rest...);
             }
+
+            write(value);
         }
 
-        std::vector<char> m_second;
-        std::vector<char> m_first;
+        text_arena m_arena;
+        text_buffer m_second{ m_arena };
+        text_buffer m_first{ m_arena };
     };
 
 
@@ -406,12 +879,12 @@ namespace cppwinrt
         }
 
         template <typename... Args>
-        std::string write_temp(std::string_view const& value, Args const& ... args)
+        std::string write_temp(format_string<sizeof...(Args)> const& format, Args const& ... args)
         {
             auto restore_indent = m_indent;
             m_indent = 0;
 
-            auto result = writer_base<T>::write_temp(value, args...);
+            auto result = writer_base<T>::write_temp(format, args...);
 
             m_indent = restore_indent;
 
@@ -0,0 +1,100 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // Records the wall clock time of each phase of a run, along with the time spent in the namespace and component
+    // writers summed over all threads. The -timings option writes these out as JSON for the benchmarks, and each
+    // phase is also added to the -profile trace.
+    struct run_timings
+    {
+        using clock = std::chrono::steady_clock;
+
+        // Adds the time elapsed between its construction and destruction to a total.
+        struct scoped_timer
+        {
+            ~scoped_timer() noexcept
+            {
+                total += elapsed(start);
+            }
+
+            std::atomic<std::uint64_t>& total;
+            clock::time_point start;
+        };
+
+        // Ends the current phase, if any, and starts the named phase.
+        void phase(std::string_view const& name)
+        {
+            stop();
+            m_phase = name;
+            m_phase_start = clock::now();
+        }
+
+        void stop()
+        {
+            if (!m_phase.empty())
+            {
+                auto const end = clock::now();
+                m_phases.emplace_back(m_phase, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - m_phase_start).count()));
+
+                if (active_profile)
+                {
+                    active_profile->add("phase", m_phase, {}, m_phase_start, end, 0);
+                }
+
+                m_phase = {};
+            }
+        }
+
+        [[nodiscard]] scoped_timer time(std::atomic<std::uint64_t>& total) const noexcept
+        {
+            return { total, clock::now() };
+        }
+
+        void write(std::string const& filename, flush_statistics const& flushed)
+        {
+            stop();
+
+            writer w;
+            w.write("{\n");
+            w.write("    \"version\": \"%\",\n", CPPWINRT_VERSION_STRING);
+            w.write("    \"total_us\": %,\n", elapsed(m_start));
+            w.write("    \"phases_us\": {");
+
+            for (auto&& [name, microseconds] : m_phases)
+            {
+                w.write("%\n        \"%\": %", &name == &m_phases.front().first ? "" : ",", name, microseconds);
+            }
+
+            w.write("\n    },\n");
+            w.write("    \"namespaces\": %,\n", namespaces.load());
+            w.write("    \"components\": %,\n", components.load());
+            w.write("    \"namespace_writers_us\": %,\n", namespace_writers.load());
+            w.write("    \"component_writers_us\": %,\n", component_writers.load());
+            w.write("    \"flush\": {\n");
+            w.write("        \"files\": %,\n", flushed.files.load());
+            w.write("        \"written\": %,\n", flushed.written.load());
+            w.write("        \"bytes\": %,\n", flushed.bytes.load());
+            w.write("        \"us\": %\n", flushed.microseconds.load());
+            w.write("    }\n");
+            w.write("}\n");
+            w.flush_to_file(filename);
+        }
+
+        std::atomic<std::uint64_t> namespaces{};
+        std::atomic<std::uint64_t> components{};
+        std::atomic<std::uint64_t> namespace_writers{};
+        std::atomic<std::uint64_t> component_writers{};
+
+    private:
+
+        static std::uint64_t elapsed(clock::time_point const& start) noexcept
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count());
+        }
+
+        clock::time_point const m_start{ clock::now() };
+        clock::time_point m_phase_start;
+        std::string_view m_phase;
+        std::vector<std::pair<std::string_view, std::uint64_t>> m_phases;
+    };
+}
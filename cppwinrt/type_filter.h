@@ -0,0 +1,205 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // Decides which types to project from include and exclude prefixes, following the rules of
+    // winmd::reader::filter: a prefix matches a type when it begins the type's full name, the longest matching prefix
+    // decides, an exclude wins over an include of the same length, and a type that no prefix matches is excluded
+    // unless there are no prefixes at all. The prefixes are compiled once into a trie that is shared by copies of
+    // the filter, so a lookup walks the namespace and name a character at a time, without building the full name or
+    // allocating.
+    struct type_filter
+    {
+        type_filter() noexcept = default;
+
+        // Each prefix is either a string or a TypeDef, whose full name is used.
+        template <typename Includes, typename Excludes>
+        type_filter(Includes const& includes, Excludes const& excludes)
+        {
+            auto nodes = std::make_shared<std::vector<node>>(1);
+
+            for (auto&& prefix : includes)
+            {
+                add(*nodes, prefix, node::include);
+            }
+
+            for (auto&& prefix : excludes)
+            {
+                add(*nodes, prefix, node::exclude);
+            }
+
+            if (nodes->size() != 1 || nodes->front().rules != 0)
+            {
+                m_nodes = std::move(nodes);
+            }
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return !m_nodes;
+        }
+
+        [[nodiscard]] bool includes(std::string_view const& type_namespace, std::string_view const& type_name) const noexcept
+        {
+            if (!m_nodes)
+            {
+                return true;
+            }
+
+            auto& nodes = *m_nodes;
+            std::uint32_t current{};
+            std::uint8_t rules = nodes.front().rules;
+
+            auto next = [&](char const c)
+            {
+                auto& children = nodes[current].children;
+                auto found = std::lower_bound(children.begin(), children.end(), c, [](auto const& child, char const value)
+                {
+                    return child.first < value;
+                });
+
+                if (found == children.end() || found->first != c)
+                {
+                    return false;
+                }
+
+                current = found->second;
+
+                if (nodes[current].rules != 0)
+                {
+                    rules = nodes[current].rules;
+                }
+
+                return true;
+            };
+
+            [&]
+            {
+                for (auto c : type_namespace)
+                {
+                    if (!next(c))
+                    {
+                        return;
+                    }
+                }
+
+                if (!next('.'))
+                {
+                    return;
+                }
+
+                for (auto c : type_name)
+                {
+                    if (!next(c))
+                    {
+                        return;
+                    }
+                }
+            }();
+
+            return rules == node::include;
+        }
+
+        // Matches a full type name, which is treated as a namespace and name already joined by a dot.
+        [[nodiscard]] bool includes(std::string_view const& type) const noexcept
+        {
+            auto const position = type.find_last_of('.');
+
+            if (position == std::string_view::npos)
+            {
+                return includes(type, {});
+            }
+
+            return includes(type.substr(0, position), type.substr(position + 1));
+        }
+
+        [[nodiscard]] bool includes(winmd::reader::TypeDef const& type) const
+        {
+            return includes(type.TypeNamespace(), type.TypeName());
+        }
+
+        [[nodiscard]] bool includes(winmd::reader::cache::namespace_members const& members) const
+        {
+            if (!m_nodes)
+            {
+                return true;
+            }
+
+            for (auto&& [name, type] : members.types)
+            {
+                if (includes(type))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+    private:
+
+        struct node
+        {
+            static constexpr std::uint8_t include{ 1 };
+            static constexpr std::uint8_t exclude{ 2 };
+
+            // Sorted by character, to be searched with lower_bound.
+            std::vector<std::pair<char, std::uint32_t>> children;
+
+            // The prefix ending at this node, if any. An exclude replaces an include of the same prefix.
+            std::uint8_t rules{};
+        };
+
+        template <typename Prefix>
+        static void add(std::vector<node>& nodes, Prefix const& prefix, std::uint8_t const rule)
+        {
+            std::uint32_t current{};
+
+            auto next = [&](char const c)
+            {
+                auto& children = nodes[current].children;
+                auto found = std::lower_bound(children.begin(), children.end(), c, [](auto const& child, char const value)
+                {
+                    return child.first < value;
+                });
+
+                if (found != children.end() && found->first == c)
+                {
+                    current = found->second;
+                    return;
+                }
+
+                auto const child = static_cast<std::uint32_t>(nodes.size());
+                children.emplace(found, c, child);
+                nodes.emplace_back();
+                current = child;
+            };
+
+            if constexpr (std::is_convertible_v<Prefix const&, std::string_view>)
+            {
+                for (auto c : std::string_view{ prefix })
+                {
+                    next(c);
+                }
+            }
+            else
+            {
+                for (auto c : prefix.TypeNamespace())
+                {
+                    next(c);
+                }
+
+                next('.');
+
+                for (auto c : prefix.TypeName())
+                {
+                    next(c);
+                }
+            }
+
+            nodes[current].rules = (std::max)(nodes[current].rules, rule);
+        }
+
+        std::shared_ptr<std::vector<node> const> m_nodes;
+    };
+}
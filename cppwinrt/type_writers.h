@@ -105,21 +105,14 @@ namespace cppwinrt
     {
         using writer_base<writer>::write;
 
-        struct depends_compare
-        {
-            bool operator()(TypeDef const& left, TypeDef const& right) const
-            {
-                return left.TypeName() < right.TypeName();
-            }
-        };
-
         std::string type_namespace;
         bool abi_types{};
         bool delegate_types{};
         bool param_names{};
         bool consume_types{};
         bool async_types{};
-        std::map<std::string_view, std::set<TypeDef, depends_compare>> depends;
+        // The types referenced from other namespaces, keyed by namespace id and holding type ids (see symbol_table).
+        std::map<std::uint32_t, std::set<std::uint32_t>> depends;
         std::vector<std::vector<std::string>> generic_param_stack;
 
         struct generic_param_guard
@@ -179,7 +172,8 @@ namespace cppwinrt
 
             if (ns != type_namespace)
             {
-                depends[ns].insert(type);
+                auto const id = symbols->type_id(type);
+                depends[symbols->namespace_id(id)].insert(id);
             }
         }
 
@@ -552,7 +546,7 @@ namespace cppwinrt
 
         void write_root_include(std::string_view const& include)
         {
-            auto format = R"(#include %winrt/%.h%
+            constexpr auto format = R"(#include %winrt/%.h%
 )";
 
             write(format,
@@ -0,0 +1,353 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // Collects the types a project uses (see -usage) together with every type the projection of those types refers
+    // to: base classes, required and implemented interfaces, factory interfaces, and the types in method, field and
+    // generic argument signatures. These are the types that writer::add_depends can reach from the used types, so
+    // projecting only these keeps every generated header self-consistent.
+    struct usage_closure
+    {
+        explicit usage_closure(cache const& c) :
+            m_cache(c)
+        {
+        }
+
+        void add(TypeDef const& type)
+        {
+            if (type && m_types.insert(type).second)
+            {
+                m_pending.push_back(type);
+            }
+        }
+
+        // Adds the type with the full name, whose generic types may be named with or without their arity suffix.
+        // Returns false if there is no such type.
+        bool add(std::string_view const& type_namespace, std::string_view const& type_name)
+        {
+            if (auto type = m_cache.find(type_namespace, type_name))
+            {
+                add(type);
+                return true;
+            }
+
+            for (char arity = '1'; arity <= '9'; ++arity)
+            {
+                std::string generic_name{ type_name };
+                generic_name += '`';
+                generic_name += arity;
+
+                if (auto type = m_cache.find(type_namespace, generic_name))
+                {
+                    add(type);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Adds every type in the namespace.
+        void add_namespace(std::string_view const& ns)
+        {
+            auto found = m_cache.namespaces().find(ns);
+
+            if (found == m_cache.namespaces().end() || !m_namespaces.insert(found->first).second)
+            {
+                return;
+            }
+
+            for (auto&& [name, type] : found->second.types)
+            {
+                add(type);
+            }
+        }
+
+        // Adds the types that the types added so far depend on, until there are no more.
+        std::set<TypeDef> const& complete()
+        {
+            while (true)
+            {
+                while (!m_pending.empty())
+                {
+                    auto const type = m_pending.back();
+                    m_pending.pop_back();
+                    add_depends(type);
+                }
+
+                for (auto&& ns : special_namespaces)
+                {
+                    if (std::any_of(m_types.begin(), m_types.end(), [&](TypeDef const& type) { return type.TypeNamespace() == ns; }))
+                    {
+                        add_namespace(ns);
+                    }
+                }
+
+                if (m_pending.empty())
+                {
+                    return m_types;
+                }
+            }
+        }
+
+    private:
+
+        void add(coded_index<TypeDefOrRef> const& type)
+        {
+            switch (type.type())
+            {
+            case TypeDefOrRef::TypeDef:
+                add(type.TypeDef());
+                break;
+            case TypeDefOrRef::TypeRef:
+                // References to System types such as System.Object and System.Guid don't resolve to a projected type.
+                add(m_cache.find(type.TypeRef().TypeNamespace(), type.TypeRef().TypeName()));
+                break;
+            case TypeDefOrRef::TypeSpec:
+                add(type.TypeSpec().Signature().GenericTypeInst());
+                break;
+            }
+        }
+
+        void add(GenericTypeInstSig const& type)
+        {
+            add(type.GenericType());
+
+            for (auto&& arg : type.GenericArgs())
+            {
+                add(arg);
+            }
+        }
+
+        void add(TypeSig const& signature)
+        {
+            call(signature.Type(),
+                [&](coded_index<TypeDefOrRef> const& type)
+                {
+                    add(type);
+                },
+                [&](GenericTypeInstSig const& type)
+                {
+                    add(type);
+                },
+                [](auto&&) {});
+        }
+
+        void add_depends(TypeDef const& type)
+        {
+            if (auto extends = type.Extends())
+            {
+                add(extends);
+            }
+
+            for (auto&& impl : type.InterfaceImpl())
+            {
+                add(impl.Interface());
+            }
+
+            for (auto&& method : type.MethodList())
+            {
+                auto const signature = method.Signature();
+
+                if (signature.ReturnType())
+                {
+                    add(signature.ReturnType().Type());
+                }
+
+                auto const params = signature.Params();
+
+                for (auto param = params.first; param != params.second; ++param)
+                {
+                    add(param->Type());
+                }
+            }
+
+            for (auto&& field : type.FieldList())
+            {
+                add(field.Signature().Type());
+            }
+
+            for (auto&& attribute : type.CustomAttribute())
+            {
+                auto const [attribute_namespace, attribute_name] = attribute.TypeNamespaceAndName();
+
+                if (attribute_namespace != "Windows.Foundation.Metadata" ||
+                    (attribute_name != "ActivatableAttribute" && attribute_name != "StaticAttribute" && attribute_name != "ComposableAttribute"))
+                {
+                    continue;
+                }
+
+                for (auto&& arg : attribute.Value().FixedArgs())
+                {
+                    if (auto type_param = std::get_if<ElemSig::SystemType>(&std::get<ElemSig>(arg.value).value))
+                    {
+                        add(m_cache.find_required(type_param->name));
+                    }
+                }
+            }
+        }
+
+        cache const& m_cache;
+        std::set<TypeDef> m_types;
+        std::vector<TypeDef> m_pending;
+        std::set<std::string_view> m_namespaces;
+    };
+
+    static bool is_usage_identifier(char const c) noexcept
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    // Adds the longest leading part of the qualified name that names a type, so that names of nested members and
+    // namespaces followed by a type name both resolve. Returns false if no part of the name is a type.
+    static bool add_usage_name(usage_closure& closure, std::vector<std::string_view> const& parts)
+    {
+        for (auto count = parts.size(); count > 1; --count)
+        {
+            std::string type_namespace;
+
+            for (std::size_t index{}; index + 1 != count; ++index)
+            {
+                if (index != 0)
+                {
+                    type_namespace += '.';
+                }
+
+                type_namespace += parts[index];
+            }
+
+            if (closure.add(type_namespace, parts[count - 1]))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Reads the types a project uses from the files given to -usage. Every name qualified with winrt:: in a file is
+    // used, such as winrt::Windows::Foundation::Uri in a source file, as is every line holding just a dotted type
+    // name, such as Windows.Foundation.Uri in a list of types. Names that don't resolve to a type are ignored.
+    static std::set<TypeDef> get_used_types(cache const& c, std::vector<std::string> const& files)
+    {
+        usage_closure closure{ c };
+
+        // The collection and async support in base.h is written against these, whether or not the project names them.
+        closure.add_namespace("Windows.Foundation");
+        closure.add_namespace("Windows.Foundation.Collections");
+
+        for (auto&& filename : files)
+        {
+            std::ifstream file(filename, std::ios::in | std::ios::binary);
+
+            if (!file)
+            {
+                throw_invalid("Cannot read usage file '", filename, "'");
+            }
+
+            std::string const text{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+            std::string_view const view{ text };
+            static constexpr std::string_view prefix{ "winrt::" };
+
+            for (auto position = view.find(prefix); position != std::string_view::npos; position = view.find(prefix, position))
+            {
+                if (position != 0 && is_usage_identifier(view[position - 1]))
+                {
+                    position += prefix.size();
+                    continue;
+                }
+
+                position += prefix.size();
+                std::vector<std::string_view> parts;
+
+                while (true)
+                {
+                    auto const end = static_cast<std::size_t>(std::find_if_not(view.begin() + position, view.end(), is_usage_identifier) - view.begin());
+
+                    if (end == position)
+                    {
+                        break;
+                    }
+
+                    parts.push_back(view.substr(position, end - position));
+                    position = end;
+
+                    if (view.substr(position, 2) != "::")
+                    {
+                        break;
+                    }
+
+                    position += 2;
+                }
+
+                add_usage_name(closure, parts);
+            }
+
+            for (std::size_t first{}; first < view.size();)
+            {
+                auto last = view.find('\n', first);
+                last = last == std::string_view::npos ? view.size() : last;
+                auto line = view.substr(first, last - first);
+                first = last + 1;
+
+                while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+                {
+                    line.remove_suffix(1);
+                }
+
+                while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+                {
+                    line.remove_prefix(1);
+                }
+
+                if (line.empty() || !std::all_of(line.begin(), line.end(), [](char const value) { return value == '.' || is_usage_identifier(value); }))
+                {
+                    continue;
+                }
+
+                std::vector<std::string_view> parts;
+
+                for (std::size_t part{}; part <= line.size();)
+                {
+                    auto const dot = (std::min)(line.find('.', part), line.size());
+                    parts.push_back(line.substr(part, dot - part));
+                    part = dot + 1;
+                }
+
+                add_usage_name(closure, parts);
+            }
+        }
+
+        return closure.complete();
+    }
+
+    // Copies the members of a namespace, keeping only the projected types in used.
+    static cache::namespace_members get_used_members(cache::namespace_members const& members, std::set<TypeDef> const& used)
+    {
+        auto result = members;
+        auto const unused = [&](TypeDef const& type) { return used.count(type) == 0; };
+
+        for (auto* types : { &result.interfaces, &result.classes, &result.enums, &result.structs, &result.delegates })
+        {
+            types->erase(std::remove_if(types->begin(), types->end(), unused), types->end());
+        }
+
+        for (auto type = result.types.begin(); type != result.types.end();)
+        {
+            auto const category = get_category(type->second);
+            auto const projected = category == category::interface_type || category == category::class_type ||
+                category == category::enum_type || category == category::struct_type || category == category::delegate_type;
+
+            if (projected && unused(type->second))
+            {
+                type = result.types.erase(type);
+            }
+            else
+            {
+                ++type;
+            }
+        }
+
+        return result;
+    }
+}
@@ -77,6 +77,212 @@ WINRT_EXPORT namespace winrt::impl
             m_value.emplace(std::move(value));
         }
     };
+
+    // The state of a collection that writers replace with a changed copy rather than change in place, so readers
+    // take a reference to the current copy without a lock and never wait for a writer. Writers copy the whole
+    // container, so this suits collections that are read far more often than they are changed.
+    template <typename Container>
+    struct snapshot_collection_base : collection_version
+    {
+        struct snapshot
+        {
+            explicit snapshot(Container&& values) : values(std::move(values))
+            {
+            }
+
+            explicit snapshot(Container const& values) : values(values)
+            {
+            }
+
+            unsigned long AddRef() noexcept
+            {
+                return ++m_references;
+            }
+
+            unsigned long Release() noexcept
+            {
+                auto const remaining = --m_references;
+
+                if (remaining == 0)
+                {
+                    delete this;
+                }
+
+                return remaining;
+            }
+
+            Container values;
+
+        private:
+
+            atomic_ref_count m_references{ 1 };
+        };
+
+        explicit snapshot_collection_base(Container&& values) : m_current(new snapshot(std::move(values)))
+        {
+        }
+
+        snapshot_collection_base(snapshot_collection_base const&) = delete;
+        snapshot_collection_base& operator=(snapshot_collection_base const&) = delete;
+
+        ~snapshot_collection_base() noexcept
+        {
+            m_current.load(std::memory_order_relaxed)->Release();
+        }
+
+        com_ptr<snapshot> get_snapshot() const noexcept
+        {
+            return m_readers.acquire(m_current);
+        }
+
+        // Publishes a copy of the container changed by change, returning what change returns. If change throws,
+        // the container is left as it was.
+        template <typename F>
+        auto update(F&& change)
+        {
+            // Extends life of the previous copy to release its values outside of lock.
+            com_ptr<snapshot> previous;
+            slim_lock_guard const guard(m_change);
+            com_ptr<snapshot> next{ new snapshot(std::as_const(m_current.load(std::memory_order_relaxed)->values)), take_ownership_from_abi };
+
+            if constexpr (std::is_void_v<decltype(change(next->values))>)
+            {
+                change(next->values);
+                previous = publish(std::move(next));
+            }
+            else
+            {
+                auto result = change(next->values);
+                previous = publish(std::move(next));
+                return result;
+            }
+        }
+
+        // Publishes the container that make returns, given the current one, without copying the current one.
+        template <typename F>
+        void replace(F&& make)
+        {
+            // Extends life of the previous copy to release its values outside of lock.
+            com_ptr<snapshot> previous;
+            slim_lock_guard const guard(m_change);
+            com_ptr<snapshot> next{ new snapshot(make(std::as_const(m_current.load(std::memory_order_relaxed)->values))), take_ownership_from_abi };
+            previous = publish(std::move(next));
+        }
+
+    private:
+
+        // The version is changed after the copy is published, and iterators read the version before the copy, so an
+        // iterator never pairs a version with an older copy.
+        com_ptr<snapshot> publish(com_ptr<snapshot> next) noexcept
+        {
+            com_ptr<snapshot> previous{ m_current.exchange(next.detach()), take_ownership_from_abi };
+            increment_version();
+            m_readers.synchronize();
+            return previous;
+        }
+
+        std::atomic<snapshot*> m_current;
+        reader_epochs m_readers;
+        slim_mutex m_change;
+    };
+
+    // Iterates over the copy of a snapshot_collection_base that was current when the iterator was created. As with
+    // the other collections, any call after the collection changes throws hresult_changed_state. A lock private to
+    // the iterator keeps GetMany atomic when the iterator itself is shared between threads.
+    template <typename D, typename T>
+    struct snapshot_iterator : collection_version::iterator_type, implements<snapshot_iterator<D, T>, wfc::IIterator<T>>
+    {
+        void abi_enter()
+        {
+            m_owner->abi_enter();
+        }
+
+        void abi_exit()
+        {
+            m_owner->abi_exit();
+        }
+
+        explicit snapshot_iterator(D* const owner) noexcept :
+            collection_version::iterator_type(*owner),
+            m_snapshot(owner->get_snapshot()),
+            m_current(std::as_const(m_snapshot->values).begin()),
+            m_end(std::as_const(m_snapshot->values).end())
+        {
+            m_owner.copy_from(owner);
+        }
+
+        T Current() const
+        {
+            slim_lock_guard const guard(m_lock);
+            check_version(*m_owner);
+
+            if (m_current == m_end)
+            {
+                throw hresult_out_of_bounds();
+            }
+
+            return current_value();
+        }
+
+        bool HasCurrent() const
+        {
+            slim_lock_guard const guard(m_lock);
+            check_version(*m_owner);
+            return m_current != m_end;
+        }
+
+        bool MoveNext()
+        {
+            slim_lock_guard const guard(m_lock);
+            check_version(*m_owner);
+
+            if (m_current != m_end)
+            {
+                ++m_current;
+            }
+
+            return m_current != m_end;
+        }
+
+        std::uint32_t GetMany(array_view<T> values)
+        {
+            slim_lock_guard const guard(m_lock);
+            check_version(*m_owner);
+            auto output = values.begin();
+
+            while (output < values.end() && m_current != m_end)
+            {
+                *output = current_value();
+                ++output;
+                ++m_current;
+            }
+
+            return static_cast<std::uint32_t>(output - values.begin());
+        }
+
+    private:
+
+        T current_value() const
+        {
+            if constexpr (!is_key_value_pair<T>::value)
+            {
+                return *m_current;
+            }
+            else
+            {
+                return make<key_value_pair<T>>(m_current->first, m_current->second);
+            }
+        }
+
+        using snapshot_type = decltype(std::declval<D const&>().get_snapshot());
+        using iterator_type = decltype(std::declval<snapshot_type const&>()->values.cbegin());
+
+        com_ptr<D> m_owner;
+        snapshot_type const m_snapshot;
+        iterator_type m_current;
+        iterator_type const m_end;
+        mutable slim_mutex m_lock;
+    };
 }
 
 WINRT_EXPORT namespace winrt
@@ -39,6 +39,403 @@ WINRT_EXPORT namespace winrt::impl
 
     template <typename K, typename V, typename Container>
     using multi_threaded_observable_map = observable_map_impl<K, V, Container, multi_threaded_collection_base>;
+
+    // A map whose keys are spread by hash over a fixed number of unordered maps, each with its own lock, so that
+    // threads using different keys rarely wait for each other. Changes to any key still invalidate every iterator.
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    struct striped_map :
+        implements<striped_map<K, V, Hash, KeyEqual, Allocator>, wfc::IMap<K, V>, wfc::IMapView<K, V>, wfc::IIterable<wfc::IKeyValuePair<K, V>>>,
+        collection_version
+    {
+        using container_type = std::unordered_map<K, V, Hash, KeyEqual, Allocator>;
+
+        explicit striped_map(container_type&& values) : m_hash(values.hash_function())
+        {
+            for (auto&& stripe : m_stripes)
+            {
+                stripe.values = container_type(0, values.hash_function(), values.key_eq(), values.get_allocator());
+            }
+
+            m_size = static_cast<std::uint32_t>(values.size());
+
+            while (!values.empty())
+            {
+                auto node = values.extract(values.begin());
+                get_stripe(node.key()).values.insert(std::move(node));
+            }
+        }
+
+        std::optional<V> TryLookup(K const& key, trylookup_from_abi_t) const
+        {
+            auto& stripe = get_stripe(key);
+            slim_shared_lock_guard const guard(stripe.lock);
+            auto pair = stripe.values.find(key);
+
+            if (pair == stripe.values.end())
+            {
+                return std::nullopt;
+            }
+
+            return pair->second;
+        }
+
+        V Lookup(K const& key) const
+        {
+            auto& stripe = get_stripe(key);
+            slim_shared_lock_guard const guard(stripe.lock);
+            auto pair = stripe.values.find(key);
+
+            if (pair == stripe.values.end())
+            {
+                throw hresult_out_of_bounds();
+            }
+
+            return pair->second;
+        }
+
+        std::uint32_t Size() const noexcept
+        {
+            return m_size;
+        }
+
+        bool HasKey(K const& key) const noexcept
+        {
+            auto& stripe = get_stripe(key);
+            slim_shared_lock_guard const guard(stripe.lock);
+            return stripe.values.find(key) != stripe.values.end();
+        }
+
+        void Split(wfc::IMapView<K, V>& first, wfc::IMapView<K, V>& second) const noexcept
+        {
+            first = nullptr;
+            second = nullptr;
+        }
+
+        wfc::IMapView<K, V> GetView() const
+        {
+            return *this;
+        }
+
+        bool Insert(K const& key, V const& value)
+        {
+            removed_value<V> oldValue;
+
+            auto& stripe = get_stripe(key);
+            slim_lock_guard const guard(stripe.lock);
+            increment_version();
+            auto [itr, added] = stripe.values.emplace(key, value);
+
+            if (added)
+            {
+                ++m_size;
+            }
+            else
+            {
+                oldValue.assign(itr->second);
+                itr->second = value;
+            }
+
+            return !added;
+        }
+
+        void Remove(K const& key)
+        {
+            typename container_type::node_type removedNode;
+
+            auto& stripe = get_stripe(key);
+            slim_lock_guard const guard(stripe.lock);
+            auto found = stripe.values.find(key);
+
+            if (found == stripe.values.end())
+            {
+                throw hresult_out_of_bounds();
+            }
+
+            increment_version();
+            removedNode = stripe.values.extract(found);
+            --m_size;
+        }
+
+        void Clear()
+        {
+            // The emptied maps are swapped with the stripes' so that their values are released outside of lock.
+            std::vector<container_type> oldContainers;
+            oldContainers.reserve(stripe_count);
+
+            for (auto&& stripe : m_stripes)
+            {
+                oldContainers.emplace_back(0, stripe.values.hash_function(), stripe.values.key_eq(), stripe.values.get_allocator());
+            }
+
+            for (auto&& stripe : m_stripes)
+            {
+                stripe.lock.lock();
+            }
+
+            increment_version();
+
+            for (std::uint32_t index{}; index != stripe_count; ++index)
+            {
+                m_stripes[index].values.swap(oldContainers[index]);
+            }
+
+            m_size = 0;
+
+            for (auto&& stripe : m_stripes)
+            {
+                stripe.lock.unlock();
+            }
+        }
+
+        auto First()
+        {
+            return make<iterator>(this);
+        }
+
+    private:
+
+        static constexpr std::uint32_t stripe_count{ 16 };
+
+        struct alignas(64) stripe
+        {
+            slim_mutex lock;
+            container_type values;
+        };
+
+        // Locks only the stripe holding the current value, so iterating doesn't hold up threads using other keys.
+        // A change to that stripe changes the version before the stripe's values, so checking the version under the
+        // stripe's lock is enough to know the iterator is still valid. A lock private to the iterator keeps GetMany
+        // atomic when the iterator itself is shared between threads.
+        struct iterator : collection_version::iterator_type, implements<iterator, wfc::IIterator<wfc::IKeyValuePair<K, V>>>
+        {
+            explicit iterator(striped_map* const owner) noexcept :
+                collection_version::iterator_type(*owner)
+            {
+                m_owner.copy_from(owner);
+                seek(0);
+            }
+
+            wfc::IKeyValuePair<K, V> Current() const
+            {
+                slim_lock_guard const guard(m_lock);
+
+                if (m_stripe == stripe_count)
+                {
+                    check_version(*m_owner);
+                    throw hresult_out_of_bounds();
+                }
+
+                slim_shared_lock_guard const stripe_guard(m_owner->m_stripes[m_stripe].lock);
+                check_version(*m_owner);
+                return make<key_value_pair<wfc::IKeyValuePair<K, V>>>(m_current->first, m_current->second);
+            }
+
+            bool HasCurrent() const
+            {
+                slim_lock_guard const guard(m_lock);
+                check_version(*m_owner);
+                return m_stripe != stripe_count;
+            }
+
+            bool MoveNext()
+            {
+                slim_lock_guard const guard(m_lock);
+
+                if (m_stripe == stripe_count)
+                {
+                    check_version(*m_owner);
+                    return false;
+                }
+
+                bool stripe_end;
+
+                {
+                    auto& stripe = m_owner->m_stripes[m_stripe];
+                    slim_shared_lock_guard const stripe_guard(stripe.lock);
+                    check_version(*m_owner);
+                    stripe_end = ++m_current == stripe.values.end();
+                }
+
+                if (stripe_end)
+                {
+                    seek(m_stripe + 1);
+                }
+
+                return m_stripe != stripe_count;
+            }
+
+            std::uint32_t GetMany(array_view<wfc::IKeyValuePair<K, V>> values)
+            {
+                slim_lock_guard const guard(m_lock);
+                auto output = values.begin();
+                check_version(*m_owner);
+
+                while (output < values.end() && m_stripe != stripe_count)
+                {
+                    bool stripe_end;
+
+                    {
+                        auto& stripe = m_owner->m_stripes[m_stripe];
+                        slim_shared_lock_guard const stripe_guard(stripe.lock);
+                        check_version(*m_owner);
+
+                        while (output < values.end() && m_current != stripe.values.end())
+                        {
+                            *output = make<key_value_pair<wfc::IKeyValuePair<K, V>>>(m_current->first, m_current->second);
+                            ++output;
+                            ++m_current;
+                        }
+
+                        stripe_end = m_current == stripe.values.end();
+                    }
+
+                    if (stripe_end)
+                    {
+                        seek(m_stripe + 1);
+                    }
+                }
+
+                return static_cast<std::uint32_t>(output - values.begin());
+            }
+
+        private:
+
+            // Moves to the first value of the first stripe from first on that has any. The version isn't checked
+            // here, as every use of the position checks it first.
+            void seek(std::uint32_t const first) noexcept
+            {
+                for (m_stripe = first; m_stripe != stripe_count; ++m_stripe)
+                {
+                    auto& stripe = m_owner->m_stripes[m_stripe];
+                    slim_shared_lock_guard const stripe_guard(stripe.lock);
+
+                    if (!stripe.values.empty())
+                    {
+                        m_current = stripe.values.begin();
+                        return;
+                    }
+                }
+            }
+
+            com_ptr<striped_map> m_owner;
+            std::uint32_t m_stripe{};
+            typename container_type::const_iterator m_current;
+            mutable slim_mutex m_lock;
+        };
+
+        stripe& get_stripe(K const& key) const noexcept
+        {
+            // The top four bits of a multiplicative hash pick the stripe, as the stripes' own buckets are chosen by the
+            // low bits of the hash.
+            static_assert(stripe_count == 16);
+            return m_stripes[static_cast<std::uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull >> 60];
+        }
+
+        Hash const m_hash;
+        mutable stripe m_stripes[stripe_count];
+        std::atomic<std::uint32_t> m_size{};
+    };
+
+    // A map that readers use without a lock, for maps that are read far more often than they are changed. Each
+    // change publishes a changed copy of the map; see snapshot_collection_base.
+    template <typename K, typename V, typename Container>
+    struct snapshot_map :
+        implements<snapshot_map<K, V, Container>, wfc::IMap<K, V>, wfc::IMapView<K, V>, wfc::IIterable<wfc::IKeyValuePair<K, V>>>,
+        snapshot_collection_base<Container>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+
+        explicit snapshot_map(Container&& values) : snapshot_collection_base<Container>(std::forward<Container>(values))
+        {
+        }
+
+        std::optional<V> TryLookup(K const& key, trylookup_from_abi_t) const
+        {
+            auto const current = this->get_snapshot();
+            auto pair = current->values.find(key);
+
+            if (pair == current->values.end())
+            {
+                return std::nullopt;
+            }
+
+            return pair->second;
+        }
+
+        V Lookup(K const& key) const
+        {
+            auto const current = this->get_snapshot();
+            auto pair = current->values.find(key);
+
+            if (pair == current->values.end())
+            {
+                throw hresult_out_of_bounds();
+            }
+
+            return pair->second;
+        }
+
+        std::uint32_t Size() const noexcept
+        {
+            return static_cast<std::uint32_t>(this->get_snapshot()->values.size());
+        }
+
+        bool HasKey(K const& key) const noexcept
+        {
+            auto const current = this->get_snapshot();
+            return current->values.find(key) != current->values.end();
+        }
+
+        void Split(wfc::IMapView<K, V>& first, wfc::IMapView<K, V>& second) const noexcept
+        {
+            first = nullptr;
+            second = nullptr;
+        }
+
+        wfc::IMapView<K, V> GetView() const
+        {
+            return *this;
+        }
+
+        bool Insert(K const& key, V const& value)
+        {
+            return this->update([&](Container& values)
+            {
+                auto [itr, added] = values.emplace(key, value);
+
+                if (!added)
+                {
+                    itr->second = value;
+                }
+
+                return !added;
+            });
+        }
+
+        void Remove(K const& key)
+        {
+            this->update([&](Container& values)
+            {
+                if (values.erase(key) == 0)
+                {
+                    throw hresult_out_of_bounds();
+                }
+            });
+        }
+
+        void Clear()
+        {
+            this->replace([](Container const& values)
+            {
+                return Container(values.get_allocator());
+            });
+        }
+
+        auto First()
+        {
+            return make<snapshot_iterator<snapshot_map, wfc::IKeyValuePair<K, V>>>(this);
+        }
+    };
 }
 
 WINRT_EXPORT namespace winrt
@@ -79,6 +476,30 @@ WINRT_EXPORT namespace winrt
         return make<impl::multi_threaded_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
     }
 
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Windows::Foundation::Collections::IMap<K, V> multi_threaded_striped_map(std::unordered_map<K, V, Hash, KeyEqual, Allocator>&& values = {})
+    {
+        return make<impl::striped_map<K, V, Hash, KeyEqual, Allocator>>(std::move(values));
+    }
+
+    template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Windows::Foundation::Collections::IMap<K, V> multi_threaded_snapshot_map()
+    {
+        return make<impl::snapshot_map<K, V, std::map<K, V, Compare, Allocator>>>(std::map<K, V, Compare, Allocator>{});
+    }
+
+    template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Windows::Foundation::Collections::IMap<K, V> multi_threaded_snapshot_map(std::map<K, V, Compare, Allocator>&& values)
+    {
+        return make<impl::snapshot_map<K, V, std::map<K, V, Compare, Allocator>>>(std::move(values));
+    }
+
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Windows::Foundation::Collections::IMap<K, V> multi_threaded_snapshot_map(std::unordered_map<K, V, Hash, KeyEqual, Allocator>&& values)
+    {
+        return make<impl::snapshot_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
+    }
+
     template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
     Windows::Foundation::Collections::IObservableMap<K, V> single_threaded_observable_map()
     {
@@ -295,6 +295,146 @@ WINRT_EXPORT namespace winrt::impl
 
     template <typename T, typename Container>
     using multi_threaded_convertible_observable_vector = convertible_observable_vector<T, Container, multi_threaded_collection_base>;
+
+    // A vector that readers use without a lock, for vectors that are read far more often than they are changed.
+    // Each change publishes a changed copy of the vector; see snapshot_collection_base.
+    template <typename T, typename Container>
+    struct snapshot_vector :
+        implements<snapshot_vector<T, Container>, wfc::IVector<T>, wfc::IVectorView<T>, wfc::IIterable<T>>,
+        snapshot_collection_base<Container>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+
+        explicit snapshot_vector(Container&& values) : snapshot_collection_base<Container>(std::forward<Container>(values))
+        {
+        }
+
+        T GetAt(std::uint32_t const index) const
+        {
+            auto const current = this->get_snapshot();
+
+            if (index >= current->values.size())
+            {
+                throw hresult_out_of_bounds();
+            }
+
+            return current->values[index];
+        }
+
+        std::uint32_t Size() const noexcept
+        {
+            return static_cast<std::uint32_t>(this->get_snapshot()->values.size());
+        }
+
+        bool IndexOf(T const& value, std::uint32_t& index) const noexcept
+        {
+            auto const current = this->get_snapshot();
+            auto const& values = current->values;
+            index = static_cast<std::uint32_t>(std::find(values.begin(), values.end(), value) - values.begin());
+            return index < values.size();
+        }
+
+        std::uint32_t GetMany(std::uint32_t const startIndex, array_view<T> values) const
+        {
+            auto const current = this->get_snapshot();
+            std::uint32_t const size = static_cast<std::uint32_t>(current->values.size());
+
+            if (startIndex >= size)
+            {
+                return 0;
+            }
+
+            std::uint32_t const actual = (std::min)(size - startIndex, values.size());
+            std::copy_n(current->values.begin() + startIndex, actual, values.begin());
+            return actual;
+        }
+
+        wfc::IVectorView<T> GetView() const noexcept
+        {
+            return *this;
+        }
+
+        void SetAt(std::uint32_t const index, T const& value)
+        {
+            this->update([&](Container& values)
+            {
+                if (index >= values.size())
+                {
+                    throw hresult_out_of_bounds();
+                }
+
+                values[index] = value;
+            });
+        }
+
+        void InsertAt(std::uint32_t const index, T const& value)
+        {
+            this->update([&](Container& values)
+            {
+                if (index > values.size())
+                {
+                    throw hresult_out_of_bounds();
+                }
+
+                values.insert(values.begin() + index, value);
+            });
+        }
+
+        void RemoveAt(std::uint32_t const index)
+        {
+            this->update([&](Container& values)
+            {
+                if (index >= values.size())
+                {
+                    throw hresult_out_of_bounds();
+                }
+
+                values.erase(values.begin() + index);
+            });
+        }
+
+        void Append(T const& value)
+        {
+            this->update([&](Container& values)
+            {
+                values.push_back(value);
+            });
+        }
+
+        void RemoveAtEnd()
+        {
+            this->update([&](Container& values)
+            {
+                if (values.empty())
+                {
+                    throw hresult_out_of_bounds();
+                }
+
+                values.pop_back();
+            });
+        }
+
+        void Clear()
+        {
+            this->replace([](Container const& values)
+            {
+                return Container(values.get_allocator());
+            });
+        }
+
+        void ReplaceAll(array_view<T const> value)
+        {
+            this->replace([&](Container const& values)
+            {
+                return Container(value.begin(), value.end(), values.get_allocator());
+            });
+        }
+
+        auto First()
+        {
+            return make<snapshot_iterator<snapshot_vector, T>>(this);
+        }
+    };
 }
 
 WINRT_EXPORT namespace winrt
@@ -311,6 +451,12 @@ WINRT_EXPORT namespace winrt
         return make<impl::multi_threaded_vector<T, std::vector<T, Allocator>>>(std::move(values));
     }
 
+    template <typename T, typename Allocator = std::allocator<T>>
+    Windows::Foundation::Collections::IVector<T> multi_threaded_snapshot_vector(std::vector<T, Allocator>&& values = {})
+    {
+        return make<impl::snapshot_vector<T, std::vector<T, Allocator>>>(std::move(values));
+    }
+
     template <typename T, typename Allocator = std::allocator<T>>
     Windows::Foundation::Collections::IObservableVector<T> single_threaded_observable_vector(std::vector<T, Allocator>&& values = {})
     {
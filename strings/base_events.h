@@ -16,6 +16,19 @@ WINRT_EXPORT namespace winrt
     struct auto_revoke_t {};
     inline constexpr auto_revoke_t auto_revoke{};
 
+    // Selects how a winrt::event stores its handlers.
+    namespace event_policy
+    {
+        // Raising the event takes a lock to share the list of handlers, and adding or removing a handler copies the
+        // list. Removed handlers are released right away.
+        struct locked {};
+
+        // Raising the event takes no lock, and adding or removing a handler doesn't copy the list, which suits events
+        // with many handlers that are raised often, from many threads. A handler removed while the event is being
+        // raised on another thread is released when the list is next compacted, rather than right away.
+        struct lock_free {};
+    }
+
     template <typename I>
     struct event_revoker
     {
@@ -334,6 +347,151 @@ WINRT_EXPORT namespace winrt::impl
         return { new(raw) event_array<T>(capacity), take_ownership_from_abi };
     }
 
+    // Lets readers reference an object published through an atomic pointer without taking a lock, while a writer
+    // replacing the object waits until no reader can still be about to reference the previous one before releasing
+    // it. Readers are counted by epoch, and the writer flips the epoch before waiting for each count to drain, so
+    // readers arriving meanwhile don't delay it. Writers must not call synchronize concurrently.
+    struct reader_epochs
+    {
+        // Takes a reference to the object the pointer holds.
+        template <typename T>
+        com_ptr<T> acquire(std::atomic<T*> const& target) const noexcept
+        {
+            auto& readers = m_readers[m_epoch.load() & 1];
+            ++readers;
+            auto const value = target.load();
+
+            if (value)
+            {
+                value->AddRef();
+            }
+
+            readers.fetch_sub(1, std::memory_order_release);
+            return { value, take_ownership_from_abi };
+        }
+
+        // Waits until no reader can still be about to reference an object it read before this call.
+        void synchronize() noexcept
+        {
+            for (int pass = 0; pass != 2; ++pass)
+            {
+                auto const& readers = m_readers[m_epoch.fetch_add(1) & 1];
+
+                while (readers.load() != 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+
+        std::atomic<std::uint32_t> m_epoch{};
+        mutable std::atomic<std::uint32_t> m_readers[2]{};
+    };
+
+    template <typename T>
+    struct event_slot
+    {
+        T delegate;
+        std::int64_t token{};
+        std::atomic<bool> removed{};
+    };
+
+    // The handlers of an event using event_policy::lock_free. Handlers are appended in place while there is room, so
+    // an event raised on another thread keeps seeing only the handlers that were there when it started, and removed
+    // handlers are marked rather than taken out, until the event compacts them into new slots.
+    template <typename T>
+    struct alignas(event_slot<T>) event_slots
+    {
+        using value_type = event_slot<T>;
+        using iterator = value_type*;
+
+        explicit event_slots(std::uint32_t const capacity) noexcept : m_capacity(capacity)
+        {
+        }
+
+        unsigned long AddRef() noexcept
+        {
+            return ++m_references;
+        }
+
+        unsigned long Release() noexcept
+        {
+            auto const remaining = --m_references;
+
+            if (remaining == 0)
+            {
+                this->~event_slots();
+                ::operator delete(static_cast<void*>(this));
+            }
+
+            return remaining;
+        }
+
+        std::uint32_t references() const noexcept
+        {
+            return m_references;
+        }
+
+        iterator begin() noexcept
+        {
+            return reinterpret_cast<iterator>(this + 1);
+        }
+
+        iterator end() noexcept
+        {
+            return begin() + size();
+        }
+
+        std::uint32_t size() const noexcept
+        {
+            return m_size.load(std::memory_order_acquire);
+        }
+
+        std::uint32_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        std::uint32_t live() const noexcept
+        {
+            return size() - m_removed;
+        }
+
+        void push_back(T const& delegate, std::int64_t const token) noexcept
+        {
+            WINRT_ASSERT(size() < m_capacity);
+            new(static_cast<void*>(end())) value_type{ delegate, token };
+            m_size.store(m_size.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        void mark_removed(value_type& slot) noexcept
+        {
+            slot.removed = true;
+            ++m_removed;
+        }
+
+        ~event_slots() noexcept
+        {
+            std::destroy(begin(), end());
+        }
+
+    private:
+
+        atomic_ref_count m_references{ 1 };
+        std::uint32_t const m_capacity;
+        std::atomic<std::uint32_t> m_size{};
+        std::uint32_t m_removed{};
+    };
+
+    template <typename T>
+    com_ptr<event_slots<T>> make_event_slots(std::uint32_t const capacity)
+    {
+        void* raw = ::operator new(sizeof(event_slots<T>) + (sizeof(event_slot<T>) * capacity));
+        return { new(raw) event_slots<T>(capacity), take_ownership_from_abi };
+    }
+
     WINRT_IMPL_NOINLINE inline bool report_failed_invoke()
     {
         std::int32_t const code = to_hresult();
@@ -367,7 +525,7 @@ WINRT_EXPORT namespace winrt::impl
 
 WINRT_EXPORT namespace winrt
 {
-    template <typename Delegate>
+    template <typename Delegate, typename Policy = event_policy::locked>
     struct event
     {
         using delegate_type = Delegate;
@@ -522,4 +680,167 @@ WINRT_EXPORT namespace winrt
         slim_mutex m_swap;
         slim_mutex m_change;
     };
+
+    template <typename Delegate>
+    struct event<Delegate, event_policy::lock_free>
+    {
+        using delegate_type = Delegate;
+
+        event() = default;
+        event(event const&) = delete;
+        event& operator =(event const&) = delete;
+
+        ~event() noexcept
+        {
+            if (auto const targets = m_targets.load(std::memory_order_relaxed))
+            {
+                targets->Release();
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_targets.load() != nullptr;
+        }
+
+        event_token add(delegate_type const& delegate)
+        {
+            return add_agile(impl::make_agile_delegate(delegate));
+        }
+
+        void remove(event_token const token)
+        {
+            // Extends life of the removed delegate and old slots to release them outside of lock.
+            delegate_type removed_delegate;
+            slots_type temp_targets;
+
+            {
+                slim_lock_guard const change_guard(m_change);
+                auto const targets = m_targets.load(std::memory_order_relaxed);
+
+                if (!targets)
+                {
+                    return;
+                }
+
+                auto const slot = std::lower_bound(targets->begin(), targets->end(), token.value, [](auto const& value, std::int64_t const key)
+                {
+                    return value.token < key;
+                });
+
+                if (slot == targets->end() || slot->token != token.value || slot->removed)
+                {
+                    return;
+                }
+
+                targets->mark_removed(*slot);
+
+                if (targets->live() == 0)
+                {
+                    temp_targets = publish(nullptr);
+                }
+                else if (targets->live() < targets->size() / 2)
+                {
+                    temp_targets = publish(compact(*targets, targets->live() * 2));
+                }
+                else
+                {
+                    // Once raises that started before the handler was marked have let go of the slots, no raise can
+                    // reach the handler, so it can be released now. Otherwise it waits for the next compaction.
+                    m_readers.synchronize();
+
+                    if (targets->references() == 1)
+                    {
+                        removed_delegate = std::move(slot->delegate);
+                    }
+                }
+            }
+        }
+
+        void clear()
+        {
+            // Extends life of old slots to release delegates outside of lock.
+            slots_type temp_targets;
+
+            {
+                slim_lock_guard const change_guard(m_change);
+
+                if (!m_targets.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                temp_targets = publish(nullptr);
+            }
+        }
+
+        template<typename...Arg>
+        void operator()(Arg const&... args)
+        {
+            if (auto const targets = m_readers.acquire(m_targets))
+            {
+                for (auto&& slot : *targets)
+                {
+                    if (!slot.removed && !impl::invoke(slot.delegate, args...))
+                    {
+                        remove(event_token{ slot.token });
+                    }
+                }
+            }
+        }
+
+    private:
+
+        using slots_type = com_ptr<impl::event_slots<delegate_type>>;
+
+        WINRT_IMPL_NOINLINE event_token add_agile(delegate_type delegate)
+        {
+            // Extends life of old slots to release delegates outside of lock.
+            slots_type temp_targets;
+            slim_lock_guard const change_guard(m_change);
+            auto const targets = m_targets.load(std::memory_order_relaxed);
+            event_token const token{ ++m_last_token };
+
+            if (targets && targets->size() < targets->capacity())
+            {
+                targets->push_back(delegate, token.value);
+            }
+            else
+            {
+                auto next = targets ? compact(*targets, targets->live() * 2 + 1) : impl::make_event_slots<delegate_type>(4);
+                next->push_back(delegate, token.value);
+                temp_targets = publish(std::move(next));
+            }
+
+            return token;
+        }
+
+        static slots_type compact(impl::event_slots<delegate_type>& targets, std::uint32_t const capacity)
+        {
+            auto result = impl::make_event_slots<delegate_type>((std::max)(capacity, 4u));
+
+            for (auto&& slot : targets)
+            {
+                if (!slot.removed)
+                {
+                    result->push_back(slot.delegate, slot.token);
+                }
+            }
+
+            return result;
+        }
+
+        // Replaces the slots, returning the previous ones once no raise can be about to reference them.
+        slots_type publish(slots_type next) noexcept
+        {
+            slots_type previous{ m_targets.exchange(next.detach()), take_ownership_from_abi };
+            m_readers.synchronize();
+            return previous;
+        }
+
+        std::atomic<impl::event_slots<delegate_type>*> m_targets{};
+        impl::reader_epochs m_readers;
+        std::int64_t m_last_token{};
+        slim_mutex m_change;
+    };
 }
@@ -1391,7 +1391,7 @@ WINRT_EXPORT namespace winrt::impl
     }
 
     template <typename T>
-    auto detach_from(T&& object) noexcept
+    auto detach_from(T&& object) noexcept(noexcept(detach_abi(std::forward<T>(object))))
     {
         return detach_abi(std::forward<T>(object));
     }
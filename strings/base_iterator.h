@@ -171,4 +171,143 @@ WINRT_EXPORT namespace winrt::impl
 
     using std::begin;
     using std::end;
+
+    // Fetches the values of a collection with GetMany, block_size values at a time, so iterating costs one call per
+    // block rather than a call for each value, which matters most when the collection is a proxy to another
+    // apartment or process. Vectors are read with GetMany(index, values) and other iterables with the GetMany of
+    // their iterator. A vector that changes during iteration may be seen partly as it was and partly as it is. The
+    // iterator owns its buffer, so like other single pass iterators it can be moved but not copied.
+    template <typename T>
+    struct batched_value
+    {
+        using type = decltype(std::declval<T const&>().First().Current());
+    };
+
+    template <typename T>
+        requires has_GetAt<T>::value
+    struct batched_value<T>
+    {
+        using type = decltype(std::declval<T const&>().GetAt(0));
+    };
+
+    template <typename T>
+    struct batched_iterator
+    {
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = typename batched_value<T>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = value_type const&;
+
+        batched_iterator() noexcept = default;
+
+        batched_iterator(T const& collection, std::uint32_t const block_size) :
+            m_buffer(new value_type[(std::max)(block_size, 1u)]{}),
+            m_size((std::max)(block_size, 1u))
+        {
+            if constexpr (has_GetAt<T>::value)
+            {
+                m_collection = collection;
+            }
+            else
+            {
+                m_collection = collection.First();
+            }
+
+            fill();
+        }
+
+        reference operator*() const noexcept
+        {
+            WINRT_ASSERT(m_current < m_count);
+            return m_buffer[m_current];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &**this;
+        }
+
+        batched_iterator& operator++()
+        {
+            if (++m_current == m_count)
+            {
+                fill();
+            }
+
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const noexcept
+        {
+            return m_count == 0;
+        }
+
+    private:
+
+        void fill()
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>)
+            {
+                // GetMany writes over the values it is given without releasing them.
+                std::fill_n(m_buffer.get(), m_count, value_type{});
+            }
+
+            array_view<value_type> buffer{ m_buffer.get(), m_buffer.get() + m_size };
+
+            if constexpr (has_GetAt<T>::value)
+            {
+                m_index += m_count;
+                m_count = m_collection.GetMany(m_index, buffer);
+            }
+            else
+            {
+                m_count = m_collection.GetMany(buffer);
+            }
+
+            m_current = 0;
+        }
+
+        std::conditional_t<has_GetAt<T>::value, T, decltype(std::declval<T const&>().First())> m_collection{ nullptr };
+        std::unique_ptr<value_type[]> m_buffer;
+        std::uint32_t m_size{};
+        std::uint32_t m_index{};
+        std::uint32_t m_count{};
+        std::uint32_t m_current{};
+    };
+
+    template <typename T>
+    struct batched_range
+    {
+        batched_iterator<T> begin() const
+        {
+            return { collection, block_size };
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+        T collection;
+        std::uint32_t block_size;
+    };
+}
+
+WINRT_EXPORT namespace winrt
+{
+    // Returns a range over a vector, vector view or other iterable that fetches its values block_size at a time with
+    // GetMany, for loops over large collections that may be proxies, such as those from other components:
+    //
+    //     for (auto&& value : winrt::batched(collection, 256))
+    template <typename T>
+    impl::batched_range<T> batched(T const& collection, std::uint32_t const block_size = 64)
+    {
+        return { collection, block_size };
+    }
 }
@@ -5,7 +5,7 @@ WINRT_EXPORT namespace winrt::impl
     {
         atomic_ref_count() noexcept = default;
 
-        explicit atomic_ref_count(std::uint32_t count) noexcept : m_count(count)
+        constexpr explicit atomic_ref_count(std::uint32_t count) noexcept : m_count(count)
         {
         }
 
@@ -62,12 +62,95 @@ WINRT_EXPORT namespace winrt::impl
         wchar_t buffer[1];
     };
 
+    // A string literal, as a template argument, from which static_hstring builds a string in static storage.
+    template <std::size_t Size>
+    struct hstring_literal
+    {
+        consteval hstring_literal(wchar_t const (&value)[Size]) noexcept
+        {
+            std::copy_n(value, Size, chars);
+        }
+
+        consteval hstring_literal(std::array<wchar_t, Size> const& value) noexcept
+        {
+            std::copy_n(value.data(), Size, chars);
+        }
+
+        wchar_t chars[Size];
+    };
+
+    // A static string is laid out as a heap string is, in writable storage, and holds a reference that is never
+    // released, so every copy shares it and any component, whether built with this library or not, may duplicate and
+    // release it as it would a heap string. It is marked with this in both padding fields, so that it may still be
+    // copied to the heap before it is handed out through the ABI, where it could outlive the module that defines it.
+    constexpr std::uint32_t hstring_static_tag{ 0x54415453 };
+
+    // Matches shared_hstring_header, but with room for the whole string in one array, since a class derived from it
+    // would not place its own members right after the base's buffer on every compiler.
+    template <std::size_t Size>
+    struct static_hstring_header
+    {
+        consteval explicit static_hstring_header(hstring_literal<Size> const& value) noexcept :
+            header{ 0, Size - 1, hstring_static_tag, hstring_static_tag, buffer },
+            count{ 1 }
+        {
+            static_assert(std::is_standard_layout_v<static_hstring_header>);
+            static_assert(offsetof(static_hstring_header, count) == sizeof(hstring_header));
+            static_assert(offsetof(static_hstring_header, buffer) == sizeof(hstring_header) + sizeof(atomic_ref_count));
+            std::copy_n(value.chars, Size, buffer);
+        }
+
+        hstring_header header;
+        atomic_ref_count count;
+        wchar_t buffer[Size];
+    };
+
+    template <hstring_literal Value>
+    inline constinit static_hstring_header static_hstring_v{ Value };
+
+    inline bool is_static_hstring(hstring_header const* handle) noexcept
+    {
+        return (handle->flags & hstring_reference_flag) == 0 &&
+            handle->padding1 == hstring_static_tag &&
+            handle->padding2 == hstring_static_tag;
+    }
+
+    // Strings allocated by heap_block_pool are marked with this in padding1, and with their class in padding2. The tag
+    // is cleared before a block goes back to the pool or the heap, but a pooled string freed by another component, or
+    // a string made by code that doesn't write the padding fields, may still carry a stale one. So a tagged block is
+    // only pooled once the heap confirms it holds at least as many bytes as its class.
+    constexpr std::uint32_t hstring_pool_tag{ 0x57504f4c };
+
+#ifdef WINRT_HSTRING_POOL
+    inline bool is_pooled_hstring(hstring_header const* handle) noexcept
+    {
+        if (handle->padding1 != hstring_pool_tag || handle->padding2 >= heap_block_pool::class_count)
+        {
+            return false;
+        }
+
+        auto const size = WINRT_IMPL_HeapSize(WINRT_IMPL_GetProcessHeap(), 0, handle);
+        return size != static_cast<std::size_t>(-1) && size >= heap_block_pool::class_size(handle->padding2);
+    }
+#endif
+
     inline void release_hstring(hstring_header* handle) noexcept
     {
         WINRT_ASSERT((handle->flags & hstring_reference_flag) == 0);
 
         if (0 == --static_cast<shared_hstring_header*>(handle)->count)
         {
+#ifdef WINRT_HSTRING_POOL
+            if (is_pooled_hstring(handle))
+            {
+                auto const size_class = handle->padding2;
+                handle->padding1 = 0;
+                heap_block_pool::release(handle, size_class);
+                return;
+            }
+#endif
+
+            handle->padding1 = 0;
             WINRT_IMPL_HeapFree(WINRT_IMPL_GetProcessHeap(), 0, handle);
         }
     }
@@ -82,13 +165,29 @@ WINRT_EXPORT namespace winrt::impl
             throw std::invalid_argument("length");
         }
 
+#ifdef WINRT_HSTRING_POOL
+        auto const size_class = heap_block_pool::get_class(static_cast<std::size_t>(bytes_required));
+
+        auto header = static_cast<shared_hstring_header*>(size_class < heap_block_pool::class_count ?
+            heap_block_pool::allocate(size_class) :
+            WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, static_cast<std::size_t>(bytes_required)));
+#else
         auto header = static_cast<shared_hstring_header*>(WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, static_cast<std::size_t>(bytes_required)));
+#endif
 
         if (!header)
         {
             throw std::bad_alloc();
         }
 
+        // The tag is cleared even without the pool, so strings made by code built without it are never mistaken for
+        // pooled strings by code built with it.
+#ifdef WINRT_HSTRING_POOL
+        header->padding1 = size_class < heap_block_pool::class_count ? hstring_pool_tag : 0;
+        header->padding2 = size_class;
+#else
+        header->padding1 = 0;
+#endif
         header->flags = 0;
         header->length = length;
         header->ptr = header->buffer;
@@ -435,14 +534,24 @@ WINRT_EXPORT namespace winrt
         *put_abi(object) = value;
     }
 
-    inline void* detach_abi(hstring& object) noexcept
+    // A static string is copied to the heap before it is handed out, so the caller's string never depends on the
+    // module that defines it.
+    inline void* detach_abi(hstring& object)
     {
         void* temp = get_abi(object);
+
+        if (temp && impl::is_static_hstring(static_cast<impl::hstring_header*>(temp)))
+        {
+            temp = impl::create_hstring_on_heap(object.data(), object.size());
+            object.clear();
+            return temp;
+        }
+
         *impl::abi_cast(object) = nullptr;
         return temp;
     }
 
-    inline void* detach_abi(hstring&& object) noexcept
+    inline void* detach_abi(hstring&& object)
     {
         return detach_abi(object);
     }
@@ -455,7 +564,16 @@ WINRT_EXPORT namespace winrt
     inline void copy_to_abi(hstring const& object, void*& value)
     {
         WINRT_ASSERT(value == nullptr);
-        value = impl::duplicate_hstring(static_cast<impl::hstring_header*>(get_abi(object)));
+        auto handle = static_cast<impl::hstring_header*>(get_abi(object));
+
+        if (handle && impl::is_static_hstring(handle))
+        {
+            value = impl::create_hstring_on_heap(handle->ptr, handle->length);
+        }
+        else
+        {
+            value = impl::duplicate_hstring(handle);
+        }
     }
 
     inline void* detach_abi(std::wstring_view const& value)
@@ -467,6 +585,40 @@ WINRT_EXPORT namespace winrt
     {
         return impl::create_hstring_on_heap(value, static_cast<std::uint32_t>(std::wcslen(value)));
     }
+
+    // Returns a string whose header and characters are built at compile time, so it is never allocated. Copies share
+    // it as they would a heap string, and detach_abi and copy_to_abi hand out a heap copy instead. It may still leave
+    // the module through an out parameter or array the callee writes to, so components that may be unloaded while
+    // callers still hold their strings should define WINRT_NO_STATIC_HSTRING, which makes it allocate a copy as usual.
+    template <impl::hstring_literal Value>
+#ifdef WINRT_NO_STATIC_HSTRING
+    hstring static_hstring()
+    {
+        return hstring{ Value.chars, static_cast<std::uint32_t>(std::size(Value.chars) - 1) };
+    }
+#else
+    hstring static_hstring() noexcept
+    {
+        if constexpr (std::size(Value.chars) == 1)
+        {
+            return {};
+        }
+        else
+        {
+            ++impl::static_hstring_v<Value>.count;
+            return { &impl::static_hstring_v<Value>.header, take_ownership_from_abi };
+        }
+    }
+#endif
+}
+
+WINRT_EXPORT namespace winrt::literals
+{
+    template <impl::hstring_literal Value>
+    hstring operator""_hs()
+    {
+        return static_hstring<Value>();
+    }
 }
 
 template<>
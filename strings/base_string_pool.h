@@ -0,0 +1,192 @@
+WINRT_EXPORT namespace winrt::impl
+{
+    // A cache of process heap blocks in a few sizes, so that code making and dropping many small blocks, such as
+    // strings, rarely calls the heap. Each thread keeps a few blocks of each size, trading batches of them with a
+    // shared list when it has too many or too few, and the shared list returns blocks to the heap once it is full.
+    // The blocks are ordinary heap blocks, so one that leaves the pool, such as a string passed to another component,
+    // may still be freed with HeapFree. Callers that mark their blocks, as release_hstring does, clear the mark before
+    // releasing a block, so that the blocks the pool holds or returns to the heap never carry a stale one.
+    struct heap_block_pool
+    {
+        static constexpr std::uint32_t class_count{ 4 };
+
+        // Returns the smallest class of block holding bytes, or class_count if bytes is too many to pool.
+        static constexpr std::uint32_t get_class(std::size_t const bytes) noexcept
+        {
+            std::uint32_t result{};
+
+            while (result != class_count && class_size(result) < bytes)
+            {
+                ++result;
+            }
+
+            return result;
+        }
+
+        static constexpr std::size_t class_size(std::uint32_t const size_class) noexcept
+        {
+            return std::size_t{ 64 } << size_class;
+        }
+
+        static void* allocate(std::uint32_t const size_class) noexcept
+        {
+            WINRT_ASSERT(size_class < class_count);
+            auto& cache = get_cache().lists[size_class];
+
+            if (!cache.first)
+            {
+                get_shared().lists[size_class].take(cache);
+            }
+
+            if (auto const block = cache.pop())
+            {
+                return block;
+            }
+
+            return WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, class_size(size_class));
+        }
+
+        static void release(void* const block, std::uint32_t const size_class) noexcept
+        {
+            WINRT_ASSERT(size_class < class_count);
+            auto& cache = get_cache().lists[size_class];
+            cache.push(block);
+
+            if (cache.count == cache_limit)
+            {
+                get_shared().lists[size_class].give(cache, cache_limit / 2);
+            }
+        }
+
+    private:
+
+        static constexpr std::uint32_t cache_limit{ 64 };
+        static constexpr std::uint32_t shared_limit{ 4096 };
+
+        // Free blocks are linked through their first bytes.
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        struct block_list
+        {
+            void push(void* const block) noexcept
+            {
+                first = new(block) free_block{ first };
+                ++count;
+            }
+
+            void* pop() noexcept
+            {
+                auto const block = first;
+
+                if (block)
+                {
+                    first = block->next;
+                    --count;
+                }
+
+                return block;
+            }
+
+            free_block* first{};
+            std::uint32_t count{};
+        };
+
+        struct shared_list
+        {
+            // Moves up to half a cache's worth of blocks to the empty cache.
+            void take(block_list& cache) noexcept
+            {
+                lock();
+
+                while (cache.count != cache_limit / 2 && m_blocks.first)
+                {
+                    cache.push(m_blocks.pop());
+                }
+
+                unlock();
+            }
+
+            // Moves count blocks from the cache, returning those the shared list has no room for to the heap.
+            void give(block_list& cache, std::uint32_t count) noexcept
+            {
+                lock();
+
+                while (count != 0 && m_blocks.count != shared_limit)
+                {
+                    m_blocks.push(cache.pop());
+                    --count;
+                }
+
+                unlock();
+
+                // The blocks were unmarked when they were released to the pool.
+                while (count != 0)
+                {
+                    WINRT_IMPL_HeapFree(WINRT_IMPL_GetProcessHeap(), 0, cache.pop());
+                    --count;
+                }
+            }
+
+        private:
+
+            // The lock is only held to move a few pointers, so waiting threads spin rather than sleep.
+            void lock() noexcept
+            {
+                while (m_lock.exchange(true, std::memory_order_acquire))
+                {
+                    while (m_lock.load(std::memory_order_relaxed))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            void unlock() noexcept
+            {
+                m_lock.store(false, std::memory_order_release);
+            }
+
+            std::atomic<bool> m_lock{};
+            block_list m_blocks;
+        };
+
+        struct shared_lists
+        {
+            shared_list lists[class_count];
+        };
+
+        struct thread_cache
+        {
+            thread_cache() = default;
+            thread_cache(thread_cache const&) = delete;
+            thread_cache& operator=(thread_cache const&) = delete;
+
+            // Hands the blocks of a thread that is exiting to the shared list.
+            ~thread_cache() noexcept
+            {
+                for (std::uint32_t size_class{}; size_class != class_count; ++size_class)
+                {
+                    get_shared().lists[size_class].give(lists[size_class], lists[size_class].count);
+                }
+            }
+
+            block_list lists[class_count];
+        };
+
+        static thread_cache& get_cache() noexcept
+        {
+            static thread_local thread_cache cache;
+            return cache;
+        }
+
+        // Never destroyed, so threads exiting during process shutdown may still hand their blocks over.
+        static shared_lists& get_shared() noexcept
+        {
+            static shared_lists* const lists = new shared_lists{};
+            return *lists;
+        }
+    };
+}
@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include <numeric>
+
+using namespace winrt;
+using namespace Windows::Foundation;
+using namespace Windows::Foundation::Collections;
+
+namespace
+{
+    // Counts the calls that reach the vector, so the test can tell that values are fetched a block at a time.
+    struct counted_vector_view : implements<counted_vector_view, IVectorView<int>, IIterable<int>>
+    {
+        explicit counted_vector_view(std::uint32_t const size) : m_size(size)
+        {
+        }
+
+        int GetAt(std::uint32_t const index)
+        {
+            ++calls;
+
+            if (index >= m_size)
+            {
+                throw hresult_out_of_bounds();
+            }
+
+            return static_cast<int>(index);
+        }
+
+        std::uint32_t Size()
+        {
+            ++calls;
+            return m_size;
+        }
+
+        bool IndexOf(int, std::uint32_t&)
+        {
+            throw hresult_not_implemented();
+        }
+
+        std::uint32_t GetMany(std::uint32_t const startIndex, array_view<int> values)
+        {
+            ++calls;
+            std::uint32_t const actual = startIndex >= m_size ? 0 : (std::min)(m_size - startIndex, values.size());
+            std::iota(values.begin(), values.begin() + actual, static_cast<int>(startIndex));
+            return actual;
+        }
+
+        IIterator<int> First()
+        {
+            throw hresult_not_implemented();
+        }
+
+        int calls{};
+
+    private:
+
+        std::uint32_t const m_size;
+    };
+}
+
+TEST_CASE("batched")
+{
+    // Vectors are read with GetMany(index, values), a block at a time.
+    {
+        auto implementation = make_self<counted_vector_view>(1000);
+        IVectorView<int> view = implementation.as<IVectorView<int>>();
+        int expected{};
+
+        for (auto&& value : batched(view, 64))
+        {
+            REQUIRE(value == expected);
+            ++expected;
+        }
+
+        REQUIRE(expected == 1000);
+        REQUIRE(implementation->calls == 17);
+    }
+
+    // Values that must be released, from a vector and from an iterable that isn't a vector.
+    {
+        auto v = single_threaded_vector<hstring>({ L"a", L"b", L"c", L"d", L"e" });
+        std::wstring joined;
+
+        for (auto&& value : batched(v, 2))
+        {
+            joined += value;
+        }
+
+        REQUIRE(joined == L"abcde");
+
+        auto m = single_threaded_map<hstring, int>(std::map<hstring, int>{ { L"one", 1 }, { L"two", 2 }, { L"three", 3 } });
+        int sum{};
+
+        for (auto&& pair : batched(m, 2))
+        {
+            sum += pair.Value();
+        }
+
+        REQUIRE(sum == 6);
+    }
+
+    // Empty collections and the default block size.
+    {
+        for (auto&& value : batched(single_threaded_vector<int>()))
+        {
+            (void)value;
+            FAIL();
+        }
+
+        for (auto&& value : batched(single_threaded_map<int, int>()))
+        {
+            (void)value;
+            FAIL();
+        }
+
+        int count{};
+
+        for (auto&& value : batched(single_threaded_vector<int>({ 1, 2, 3 }).GetView()))
+        {
+            count += value;
+        }
+
+        REQUIRE(count == 6);
+    }
+}
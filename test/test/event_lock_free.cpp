@@ -0,0 +1,155 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    using lock_free_event = event<TypedEventHandler<int, int>, event_policy::lock_free>;
+}
+
+//
+// Checks that an event using event_policy::lock_free adds, removes and clears handlers like the default event.
+//
+
+TEST_CASE("event_lock_free")
+{
+    lock_free_event event;
+    REQUIRE(!event);
+    int counter{};
+
+    auto a = event.add([&](auto && ...)
+        {
+            counter += 1;
+        });
+
+    auto b = event.add([&](auto && ...)
+        {
+            counter += 10;
+        });
+
+    REQUIRE(event);
+    event(0, 0);
+    REQUIRE(counter == 11);
+
+    event.remove(a);
+    counter = 0;
+    event(0, 0);
+    REQUIRE(counter == 10);
+
+    // Removing twice has no effect.
+    event.remove(a);
+    counter = 0;
+    event(0, 0);
+    REQUIRE(counter == 10);
+
+    event.remove(b);
+    REQUIRE(!event);
+
+    std::vector<event_token> tokens;
+
+    for (int index{}; index != 100; ++index)
+    {
+        tokens.push_back(event.add([&](auto && ...)
+            {
+                counter += 1;
+            }));
+    }
+
+    for (std::size_t index{}; index < tokens.size(); index += 2)
+    {
+        event.remove(tokens[index]);
+    }
+
+    counter = 0;
+    event(0, 0);
+    REQUIRE(counter == 50);
+
+    event.clear();
+    REQUIRE(!event);
+    counter = 0;
+    event(0, 0);
+    REQUIRE(counter == 0);
+}
+
+//
+// Checks that a handler that has been disconnected is removed when the event is raised.
+//
+
+TEST_CASE("event_lock_free_invalid")
+{
+    lock_free_event event;
+    int counter{};
+
+    event.add([&](auto && ...)
+        {
+            ++counter;
+            throw hresult_error(RPC_E_DISCONNECTED);
+        });
+
+    event(0, 0);
+    event(0, 0);
+    REQUIRE(counter == 1);
+    REQUIRE(!event);
+}
+
+//
+// Checks that handlers added and removed on some threads while others raise the event are raised exactly while
+// they are added.
+//
+
+TEST_CASE("event_lock_free_threads")
+{
+    lock_free_event event;
+    std::atomic<bool> done{};
+    std::atomic<int> counter{};
+    std::vector<std::thread> raisers;
+
+    for (int index{}; index != 4; ++index)
+    {
+        raisers.emplace_back([&]
+            {
+                while (!done)
+                {
+                    event(0, 0);
+                }
+            });
+    }
+
+    std::vector<std::thread> changers;
+
+    for (int index{}; index != 2; ++index)
+    {
+        changers.emplace_back([&]
+            {
+                for (int change{}; change != 5'000; ++change)
+                {
+                    auto token = event.add([&](auto && ...)
+                        {
+                            ++counter;
+                        });
+
+                    if (change % 2)
+                    {
+                        event.remove(token);
+                    }
+                }
+            });
+    }
+
+    for (auto&& changer : changers)
+    {
+        changer.join();
+    }
+
+    done = true;
+
+    for (auto&& raiser : raisers)
+    {
+        raiser.join();
+    }
+
+    counter = 0;
+    event(0, 0);
+    REQUIRE(counter == 5'000);
+}
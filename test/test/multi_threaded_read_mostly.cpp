@@ -0,0 +1,229 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+using namespace Windows::Foundation::Collections;
+
+// Tests for the collections that let readers proceed without waiting for each other: multi_threaded_striped_map,
+// multi_threaded_snapshot_map and multi_threaded_snapshot_vector.
+
+namespace
+{
+    template <typename Map>
+    void test_map(Map const& m)
+    {
+        REQUIRE(!m.Insert(1, L"one"));
+        REQUIRE(!m.Insert(2, L"two"));
+        REQUIRE(m.Insert(2, L"TWO"));
+        REQUIRE(m.Size() == 2);
+        REQUIRE(m.Lookup(2) == L"TWO");
+        REQUIRE(m.HasKey(1));
+        REQUIRE(!m.HasKey(3));
+        REQUIRE_THROWS_AS(m.Lookup(3), hresult_out_of_bounds);
+        REQUIRE_THROWS_AS(m.Remove(3), hresult_out_of_bounds);
+
+        int count{};
+
+        for (auto&& [key, value] : m)
+        {
+            REQUIRE(m.Lookup(key) == value);
+            ++count;
+        }
+
+        REQUIRE(count == 2);
+
+        // Changes invalidate iterators, as with the other collections.
+        auto iterator = m.First();
+        m.Remove(1);
+        REQUIRE(m.Size() == 1);
+        REQUIRE_THROWS_AS(iterator.MoveNext(), hresult_changed_state);
+        REQUIRE_THROWS_AS(iterator.Current(), hresult_changed_state);
+
+        m.Clear();
+        REQUIRE(m.Size() == 0);
+        REQUIRE(!m.First().HasCurrent());
+
+        // Readers iterate and look up keys while writers change them. Catch2 isn't thread safe, so the readers only
+        // count failures.
+        std::atomic<bool> done{};
+        std::atomic<int> failures{};
+        std::vector<std::thread> readers;
+
+        for (int index{}; index != 4; ++index)
+        {
+            readers.emplace_back([&]
+                {
+                    while (!done)
+                    {
+                        for (int key{}; key != 64; ++key)
+                        {
+                            if (auto value = m.TryLookup(key); value && *value != L"value")
+                            {
+                                ++failures;
+                            }
+                        }
+
+                        try
+                        {
+                            IKeyValuePair<int, hstring> values[8];
+                            auto iterator = m.First();
+
+                            while (iterator.GetMany(values) != 0)
+                            {
+                            }
+                        }
+                        catch (hresult_changed_state const&)
+                        {
+                        }
+                    }
+                });
+        }
+
+        for (int change{}; change != 10'000; ++change)
+        {
+            m.Insert(change % 64, L"value");
+
+            if (change % 2)
+            {
+                m.Remove(change % 64);
+            }
+        }
+
+        done = true;
+
+        for (auto&& reader : readers)
+        {
+            reader.join();
+        }
+
+        REQUIRE(failures == 0);
+        REQUIRE(m.Size() == 32);
+    }
+}
+
+TEST_CASE("multi_threaded_striped_map")
+{
+    test_map(multi_threaded_striped_map<int, hstring>());
+
+    auto m = multi_threaded_striped_map<int, hstring>({ { 1, L"one" }, { 2, L"two" } });
+    REQUIRE(m.Size() == 2);
+    REQUIRE(m.Lookup(1) == L"one");
+
+    // GetMany is atomic, so threads sharing an iterator never see the same pair.
+    for (int key = 3; key != 100; ++key)
+    {
+        m.Insert(key, L"value");
+    }
+
+    auto iterator = m.First();
+    std::vector<int> first;
+    std::vector<int> second;
+
+    auto take = [&](std::vector<int>& keys)
+    {
+        IKeyValuePair<int, hstring> values[3];
+
+        while (auto const count = iterator.GetMany(values))
+        {
+            for (std::uint32_t index{}; index != count; ++index)
+            {
+                keys.push_back(values[index].Key());
+            }
+        }
+    };
+
+    std::thread other([&] { take(second); });
+    take(first);
+    other.join();
+
+    first.insert(first.end(), second.begin(), second.end());
+    std::sort(first.begin(), first.end());
+    REQUIRE(first.size() == 99);
+    REQUIRE(std::adjacent_find(first.begin(), first.end()) == first.end());
+}
+
+TEST_CASE("multi_threaded_snapshot_map")
+{
+    test_map(multi_threaded_snapshot_map<int, hstring>());
+    test_map(multi_threaded_snapshot_map(std::unordered_map<int, hstring>{}));
+
+    auto m = multi_threaded_snapshot_map(std::map<int, hstring>{ { 1, L"one" } });
+    REQUIRE(m.Lookup(1) == L"one");
+}
+
+TEST_CASE("multi_threaded_snapshot_vector")
+{
+    auto v = multi_threaded_snapshot_vector<int>({ 1, 2, 3 });
+    v.Append(4);
+    v.InsertAt(0, 0);
+    v.RemoveAt(1);
+    v.SetAt(0, 10);
+    v.RemoveAtEnd();
+    REQUIRE(v.Size() == 3);
+    REQUIRE(v.GetAt(0) == 10);
+    REQUIRE(v.GetAt(2) == 3);
+    REQUIRE_THROWS_AS(v.GetAt(3), hresult_out_of_bounds);
+    REQUIRE_THROWS_AS(v.SetAt(3, 0), hresult_out_of_bounds);
+    REQUIRE_THROWS_AS(v.InsertAt(4, 0), hresult_out_of_bounds);
+    REQUIRE(v.Size() == 3);
+
+    std::uint32_t index{};
+    REQUIRE(v.IndexOf(3, index));
+    REQUIRE(index == 2);
+    REQUIRE(!v.IndexOf(4, index));
+
+    int values[4]{};
+    REQUIRE(v.GetMany(1, values) == 2);
+    REQUIRE(values[0] == 2);
+    REQUIRE(values[1] == 3);
+
+    // Changes invalidate iterators, as with the other collections.
+    auto iterator = v.First();
+    REQUIRE(iterator.Current() == 10);
+    v.Append(5);
+    REQUIRE_THROWS_AS(iterator.Current(), hresult_changed_state);
+
+    v.ReplaceAll({ 7, 8 });
+    REQUIRE(v.Size() == 2);
+    REQUIRE(v.GetView().GetAt(1) == 8);
+
+    v.Clear();
+    REQUIRE(v.Size() == 0);
+    REQUIRE_THROWS_AS(v.RemoveAtEnd(), hresult_out_of_bounds);
+
+    // Readers always see a vector some writer published, never one being changed.
+    std::atomic<bool> done{};
+    std::atomic<int> failures{};
+    std::vector<std::thread> readers;
+
+    for (int reader{}; reader != 4; ++reader)
+    {
+        readers.emplace_back([&]
+            {
+                while (!done)
+                {
+                    int current[3]{};
+                    auto const count = v.GetMany(0, current);
+
+                    if (count != 0 && (count != 3 || current[0] != current[1] || current[1] != current[2]))
+                    {
+                        ++failures;
+                    }
+                }
+            });
+    }
+
+    for (int change{}; change != 1'000; ++change)
+    {
+        v.ReplaceAll({ change, change, change });
+    }
+
+    done = true;
+
+    for (auto&& reader : readers)
+    {
+        reader.join();
+    }
+
+    REQUIRE(failures == 0);
+}
@@ -0,0 +1,113 @@
+#include "pch.h"
+#include <windows.foundation.h>
+
+using namespace winrt;
+using namespace winrt::literals;
+using namespace Windows::Foundation;
+
+namespace
+{
+    // The release_hstring of code built without static strings, which only knows heap strings.
+    void release_as_baseline(void* value)
+    {
+        auto handle = static_cast<impl::hstring_header*>(value);
+        REQUIRE((handle->flags & impl::hstring_reference_flag) == 0);
+
+        if (0 == --static_cast<impl::shared_hstring_header*>(handle)->count)
+        {
+            REQUIRE(HeapFree(GetProcessHeap(), 0, handle));
+        }
+    }
+
+    struct stringable : implements<stringable, IStringable>
+    {
+        hstring ToString()
+        {
+            return L"stringable"_hs;
+        }
+    };
+}
+
+TEST_CASE("static_hstring")
+{
+    hstring a = L"static"_hs;
+    REQUIRE(a == L"static");
+    REQUIRE(a.size() == 6);
+    REQUIRE(wcslen(a.c_str()) == 6);
+
+    // The same literal is the same string, and copies share it.
+    hstring b = static_hstring<L"static">();
+    hstring c = a;
+    REQUIRE(get_abi(a) == get_abi(b));
+    REQUIRE(get_abi(a) == get_abi(c));
+
+    c = L"other"_hs;
+    REQUIRE(c == L"other");
+    REQUIRE(a == L"static");
+
+    // Empty literals are empty strings.
+    REQUIRE((L""_hs).empty());
+    REQUIRE(get_abi(L""_hs) == nullptr);
+
+    // Embedded nulls are kept, as with any other string.
+    REQUIRE((L"a\0b"_hs).size() == 3);
+
+    // To the Windows Runtime a static string is a heap string it shares, and whose last reference it never holds.
+    HSTRING copy{};
+    REQUIRE(S_OK == WindowsDuplicateString(static_cast<HSTRING>(get_abi(a)), &copy));
+    REQUIRE(WindowsGetStringRawBuffer(copy, nullptr) == L"static"sv);
+    REQUIRE(S_OK == WindowsDeleteString(copy));
+    REQUIRE(a == L"static");
+
+    // Returned through the ABI as a heap copy, which the caller owns.
+    IStringable stringable = make<::stringable>();
+    hstring first = stringable.ToString();
+    hstring second = stringable.ToString();
+    REQUIRE(first == L"stringable");
+    REQUIRE(get_abi(first) != get_abi(second));
+    REQUIRE(get_abi(first) != get_abi(L"stringable"_hs));
+
+    // Runtime class names are owned strings.
+    REQUIRE(get_class_name(stringable) == get_class_name(stringable));
+
+    // Copies of a string borrowed from the caller are still made on the heap, since it only lives during the call.
+    std::wstring text = L"borrowed";
+    param::hstring borrowed{ text };
+    hstring owned = static_cast<hstring const&>(borrowed);
+    REQUIRE(get_abi(owned) != get_abi(borrowed));
+    text[0] = L'B';
+    REQUIRE(owned == L"borrowed");
+}
+
+TEST_CASE("static_hstring released by other components")
+{
+    hstring value = L"released"_hs;
+
+    // Strings handed out through the ABI may be released by code that knows nothing of static strings.
+    void* detached = detach_abi(hstring{ value });
+    REQUIRE(detached != get_abi(value));
+    release_as_baseline(detached);
+
+    void* copied{};
+    copy_to_abi(value, copied);
+    REQUIRE(copied != get_abi(value));
+    release_as_baseline(copied);
+
+    IStringable stringable = make<::stringable>();
+    auto abi = static_cast<ABI::Windows::Foundation::IStringable*>(get_abi(stringable));
+    HSTRING returned{};
+    REQUIRE(S_OK == abi->ToString(&returned));
+    REQUIRE(WindowsGetStringRawBuffer(returned, nullptr) == L"stringable"sv);
+    release_as_baseline(returned);
+
+    HSTRING name{};
+    REQUIRE(S_OK == abi->GetRuntimeClassName(&name));
+    release_as_baseline(name);
+
+    // An out parameter the callee writes to directly shares the static string, which may be released as well.
+    void* out{};
+    *reinterpret_cast<hstring*>(&out) = value;
+    REQUIRE(out == get_abi(value));
+    release_as_baseline(out);
+    REQUIRE(value == L"released");
+}